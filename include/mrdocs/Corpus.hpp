@@ -17,8 +17,14 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Config.hpp>
 #include <mrdocs/Metadata.hpp>
+#include <compare>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -26,30 +32,44 @@
 
 namespace clang::mrdocs {
 
+class NameTable;
+class SymbolLookup;
+
 /** The collection of declarations in extracted form.
 */
 class MRDOCS_VISIBLE
     Corpus
 {
+    // The tables of the default implementations
+    // of lookup, parents and qualifiedName, which
+    // are built the first time they are used
+    mutable std::once_flag defaultLookupOnce_;
+    mutable std::unique_ptr<SymbolLookup> defaultLookup_;
+    mutable std::once_flag defaultNamesOnce_;
+    mutable std::unique_ptr<NameTable> defaultNames_;
+
+    NameTable const&
+    defaultNames() const;
+
 protected:
+    MRDOCS_DECL
     explicit
     Corpus(
-        Config const& config_) noexcept
-        : config(config_)
-    {
-    }
+        Config const& config_) noexcept;
+
 public:
     /** The iterator type for the index of all symbols.
 
-        The iterator is a forward iterator that
-        iterates over all symbols in the index.
+        The iterator is a random access iterator
+        that iterates over all symbols in the index.
         It dereferences to a reference to a
         const @ref Info.
 
-        The logic for incrementing the iterator is
-        provided by the Corpus implementation via
-        a function that retuns the next Info in the
-        index, or nullptr if there are no more.
+        The index is a contiguous array of pointers
+        to the symbols sorted by symbol ID, so the
+        order of iteration is deterministic, and
+        the index can be divided into ranges which
+        are processed in parallel.
     */
     class iterator;
 
@@ -85,6 +105,12 @@ public:
     bool
     empty() const noexcept;
 
+    /** Return the number of symbols in the index.
+    */
+    MRDOCS_DECL
+    std::size_t
+    size() const noexcept;
+
     /** Return the Info with the matching ID, or nullptr.
     */
     MRDOCS_DECL
@@ -92,6 +118,33 @@ public:
     Info const*
     find(SymbolID const& id) const noexcept = 0;
 
+    /** Return the Info named by an id-expression, or nullptr.
+
+        The name is looked up as if it appeared in
+        the documentation of the symbol `context`,
+        which is how references such as `@ref` are
+        resolved. Qualified names are looked up in
+        the context named by their nested-name-specifier.
+
+        The lookup tables are built once for the whole
+        corpus, so this function may be called
+        concurrently from any number of threads.
+
+        The default implementation builds the tables
+        the first time it is called, so derived
+        classes which were written before this
+        function was added keep working.
+
+        @param context The symbol ID of the context.
+        @param name The id-expression to lookup.
+    */
+    MRDOCS_DECL
+    virtual
+    Info const*
+    lookup(
+        SymbolID const& context,
+        std::string_view name) const;
+
     /** Return true if an Info with the specified symbol ID exists.
 
         This function uses the @ref find function to locate
@@ -221,16 +274,46 @@ public:
 
     //--------------------------------------------
 
+    /** Return the parents of the specified Info.
+
+        The parents are ordered from the outermost
+        scope, which is the global namespace, to
+        the parent of `I`.
+
+        The parents of every symbol are computed
+        once for the corpus, so this function
+        does not allocate after the first call.
+        The default implementation computes them
+        the first time it is called.
+     */
+    MRDOCS_DECL
+    virtual
+    std::span<SymbolID const>
+    parents(Info const& I) const noexcept;
+
     /** Return the fully qualified name of the specified Info.
 
-        This function returns the fully qualified name
-        of the specified Info `I` as a string.
+        The qualified names of every symbol are
+        computed once for the corpus, and the
+        returned view is valid for the lifetime
+        of the corpus. The default implementation
+        computes them the first time it is called.
 
-        The `Info` parents are traversed to construct
-        the fully qualified name which is stored in
-        the string `temp`.
+        @note This function used to return a
+        `std::string`. Callers which need a string
+        construct it from the view, or use the
+        overload which assigns the name to a string.
+     */
+    MRDOCS_DECL
+    virtual
+    std::string_view
+    qualifiedName(Info const& I) const noexcept;
 
-        @return A reference to the string `temp`.
+    /** Return the fully qualified name of the specified Info.
+
+        This function stores the fully qualified
+        name of the specified Info `I` in the
+        string `temp`.
      */
     MRDOCS_DECL
     void
@@ -238,14 +321,6 @@ public:
         Info const& I,
         std::string& temp) const;
 
-    std::string
-    qualifiedName(const Info& I) const
-    {
-        std::string temp;
-        qualifiedName(I, temp);
-        return temp;
-    }
-
 };
 
 //------------------------------------------------
@@ -344,11 +419,11 @@ orderedTraverseOverloads(
 
 class Corpus::iterator
 {
-    const Corpus* corpus_;
-    const Info* val_;
-    const Info*(*next_)(const Corpus*, const Info*);
+    const Info* const* it_ = nullptr;
 
 public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
     using value_type = const Info;
     using size_type = std::size_t;
     using difference_type = std::ptrdiff_t;
@@ -361,55 +436,128 @@ public:
     iterator(const iterator&) = default;
     iterator& operator=(const iterator&) = default;
 
-    iterator(
-        const Corpus* corpus,
-        const Info* val,
-        const Info*(*next)(const Corpus*, const Info*))
-        : corpus_(corpus)
-        , val_(val)
-        , next_(next)
+    /** Constructor.
+
+        @param it A pointer to an element of
+        the index of the corpus.
+    */
+    explicit
+    iterator(const Info* const* it) noexcept
+        : it_(it)
     {
     }
 
     iterator& operator++() noexcept
     {
-        MRDOCS_ASSERT(val_);
-        val_ = next_(corpus_, val_);
+        ++it_;
         return *this;
     }
 
     iterator operator++(int) noexcept
     {
-        MRDOCS_ASSERT(val_);
         auto temp = *this;
-        val_ = next_(corpus_, val_);
+        ++it_;
+        return temp;
+    }
+
+    iterator& operator--() noexcept
+    {
+        --it_;
+        return *this;
+    }
+
+    iterator operator--(int) noexcept
+    {
+        auto temp = *this;
+        --it_;
         return temp;
     }
 
+    iterator& operator+=(difference_type n) noexcept
+    {
+        it_ += n;
+        return *this;
+    }
+
+    iterator& operator-=(difference_type n) noexcept
+    {
+        it_ -= n;
+        return *this;
+    }
+
+    friend iterator operator+(iterator it, difference_type n) noexcept
+    {
+        return it += n;
+    }
+
+    friend iterator operator+(difference_type n, iterator it) noexcept
+    {
+        return it += n;
+    }
+
+    friend iterator operator-(iterator it, difference_type n) noexcept
+    {
+        return it -= n;
+    }
+
+    friend difference_type operator-(iterator const& lhs, iterator const& rhs) noexcept
+    {
+        return lhs.it_ - rhs.it_;
+    }
+
     const_pointer operator->() const noexcept
     {
-        MRDOCS_ASSERT(val_);
-        return val_;
+        MRDOCS_ASSERT(it_ && *it_);
+        return *it_;
     }
 
     const_reference operator*() const noexcept
     {
-        MRDOCS_ASSERT(val_);
-        return *val_;
+        MRDOCS_ASSERT(it_ && *it_);
+        return **it_;
+    }
+
+    const_reference operator[](difference_type n) const noexcept
+    {
+        MRDOCS_ASSERT(it_ && it_[n]);
+        return *it_[n];
     }
 
     bool operator==(iterator const& other) const noexcept
     {
-        return val_ == other.val_;
+        return it_ == other.it_;
     }
 
-    bool operator!=(iterator const& other) const noexcept
+    auto operator<=>(iterator const& other) const noexcept
     {
-        return val_ != other.val_;
+        return std::compare_three_way{}(it_, other.it_);
     }
 };
 
+/** Return a range of the index of all symbols.
+
+    The index is divided into `n` ranges whose
+    sizes differ by at most one symbol, and
+    the range at position `i` is returned.
+
+    This allows the symbols to be processed
+    by `n` tasks in parallel.
+
+    @param C The corpus.
+    @param i The position of the range, which
+    must be less than `n`.
+    @param n The number of ranges.
+ */
+MRDOCS_DECL
+std::ranges::subrange<Corpus::iterator>
+partitionIndex(
+    Corpus const& C,
+    std::size_t i,
+    std::size_t n) noexcept;
+
 /** Return a list of the parent symbols of the specified Info.
+
+    @see Corpus::parents
  */
 MRDOCS_DECL
 std::vector<SymbolID>
@@ -20,6 +20,7 @@ namespace mrdocs {
 namespace dom {
 
 class String;
+class StringPool;
 
 /** Satisfied if StringTy is convertible to String but not a String.
 */
@@ -55,6 +56,24 @@ class MRDOCS_DECL
         const char* s,
         std::size_t n);
 
+    friend class StringPool;
+
+    struct literal_tag {};
+
+    /** Construct a string which references a buffer.
+
+        The string is stored as a string literal.
+        The buffer must be null-terminated, and
+        must not contain null characters.
+    */
+    constexpr
+    String(
+        const char* str,
+        literal_tag) noexcept
+        : ptr_(str)
+    {
+    }
+
 public:
     /** Constructor.
 
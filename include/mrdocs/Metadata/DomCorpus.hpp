@@ -17,6 +17,7 @@
 #include <mrdocs/Corpus.hpp>
 #include <mrdocs/Dom.hpp>
 #include <mrdocs/Metadata.hpp>
+#include <cstddef>
 #include <type_traits>
 #include <memory>
 
@@ -105,6 +106,52 @@ public:
     dom::Value
     get(SymbolID const& id) const;
 
+    /** Return an interned string with the same contents.
+
+        Each distinct string is stored once for the
+        lifetime of the DomCorpus, and the returned
+        strings reference it without allocating or
+        counting references. The returned strings
+        must not outlive the DomCorpus.
+
+        The pool only grows, so this is meant for
+        strings which repeat across the corpus,
+        such as names and URLs. Other strings,
+        such as documentation text, are converted
+        to ref-counted strings instead.
+    */
+    dom::String
+    intern(std::string_view str) const;
+
+    /** Statistics of the cache of Dom objects.
+    */
+    struct CacheStats
+    {
+        /** The number of objects found in the cache.
+        */
+        std::size_t hits = 0;
+
+        /** The number of objects created for the first time.
+        */
+        std::size_t misses = 0;
+
+        /** The number of objects created again after
+            they were released from the cache.
+        */
+        std::size_t rebuilds = 0;
+    };
+
+    /** Return the statistics of the cache of Dom objects.
+
+        The objects returned by @ref get are cached
+        and shared between the callers. Namespaces
+        are always retained, and other symbols are
+        retained while they are referenced or among
+        the `dom-cache-size` most recently used.
+    */
+    CacheStats
+    cacheStats() const;
+
     /** Return a Dom value representing the Javadoc.
 
         The default implementation returns null. A
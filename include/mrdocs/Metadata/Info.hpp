@@ -18,6 +18,7 @@
 #include <mrdocs/Metadata/Specifiers.hpp>
 #include <mrdocs/Metadata/Symbols.hpp>
 #include <mrdocs/Metadata/ExtractionMode.hpp>
+#include <mrdocs/Support/ArenaAllocated.hpp>
 #include <mrdocs/Support/Visitor.hpp>
 #include <memory>
 #include <string>
@@ -60,6 +61,7 @@ tag_invoke(
 */
 struct MRDOCS_VISIBLE
     Info
+    : ArenaAllocated
 {
     /** The unique identifier for this symbol.
     */
@@ -16,6 +16,7 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Dom.hpp>
 #include <mrdocs/Metadata/Symbols.hpp>
+#include <mrdocs/Support/ArenaAllocated.hpp>
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/Visitor.hpp>
 #include <memory>
@@ -181,6 +182,7 @@ enum class Parts
 */
 struct MRDOCS_DECL
     Node
+    : ArenaAllocated
 {
     Kind kind;
 
@@ -49,6 +49,7 @@ tag_invoke(
     so that it can be referenced in the documentation.
  */
 struct NameInfo
+    : ArenaAllocated
 {
     /** The kind of name this is.
     */
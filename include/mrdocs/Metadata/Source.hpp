@@ -16,6 +16,8 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/ADT/Optional.hpp>
 #include <mrdocs/Metadata/Info.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 
@@ -46,24 +48,96 @@ tag_invoke(
     v = toString(kind);
 }
 
-struct MRDOCS_DECL
-    Location
+/** A file in the file table.
+
+    The strings are owned by the table and
+    remain valid for the lifetime of the program.
+*/
+struct SourceFile
 {
     /** The full file path
     */
-    std::string Path;
+    std::string_view Path;
 
     /** Name of the file
     */
-    std::string Filename;
-
-    /** Line number within the file
-    */
-    unsigned LineNumber = 0;
+    std::string_view Filename;
 
     /** The kind of file this is
     */
     FileKind Kind = FileKind::Source;
+};
+
+/** The table of the files referred to by locations.
+
+    Locations refer to their file with an ID, so
+    the paths of a file are stored once regardless
+    of how many declarations it contains.
+
+    The table is shared by the translation units,
+    which add files concurrently, and by the corpus
+    built from them. Files are never removed, and
+    the ID 0 refers to no file.
+*/
+class MRDOCS_DECL
+    FileTable
+{
+    struct Impl;
+
+    Impl& impl_;
+
+    explicit FileTable(Impl& impl) noexcept;
+
+public:
+    FileTable(FileTable const&) = delete;
+    FileTable& operator=(FileTable const&) = delete;
+
+    /** Return the table.
+    */
+    static
+    FileTable&
+    instance() noexcept;
+
+    /** Return the ID of a file, adding it if needed.
+
+        Files are identified by their full path,
+        short name, and kind. The short name and
+        the kind depend on the configuration, so
+        corpora with different configurations in
+        the same process refer to different files.
+
+        @return The ID of the file, or 0 if
+        the path is empty.
+    */
+    std::uint32_t
+    add(
+        std::string_view path,
+        std::string_view filename,
+        FileKind kind);
+
+    /** Return the file with the specified ID.
+
+        The ID 0 returns an empty file.
+    */
+    SourceFile
+    get(std::uint32_t id) const noexcept;
+
+    /** Return the number of files in the table.
+    */
+    std::size_t
+    size() const noexcept;
+};
+
+struct MRDOCS_DECL
+    Location
+{
+    /** The ID of the file in the file table
+    */
+    std::uint32_t FileId = 0;
+
+    /** Line number within the file
+    */
+    unsigned LineNumber = 0;
 
     /** Whether this location has documentation.
     */
@@ -71,19 +145,59 @@ struct MRDOCS_DECL
 
     //--------------------------------------------
 
+    constexpr
     Location(
-        std::string_view const filepath = {},
-        std::string_view const filename = {},
+        std::uint32_t const fileId = 0,
         unsigned const line = 0,
-        FileKind const kind = FileKind::Source,
-        bool const documented = false)
-        : Path(filepath)
-        , Filename(filename)
+        bool const documented = false) noexcept
+        : FileId(fileId)
         , LineNumber(line)
-        , Kind(kind)
         , Documented(documented)
     {
     }
+
+    /** Constructor.
+
+        The file is added to the file table.
+    */
+    Location(
+        std::string_view filepath,
+        std::string_view filename,
+        unsigned line = 0,
+        FileKind kind = FileKind::Source,
+        bool documented = false);
+
+    /** Return the file of this location.
+    */
+    SourceFile
+    file() const noexcept
+    {
+        return FileTable::instance().get(FileId);
+    }
+
+    /** Return the full file path
+    */
+    std::string_view
+    path() const noexcept
+    {
+        return file().Path;
+    }
+
+    /** Return the name of the file
+    */
+    std::string_view
+    filename() const noexcept
+    {
+        return file().Filename;
+    }
+
+    /** Return the kind of file this is
+    */
+    FileKind
+    kind() const noexcept
+    {
+        return file().Kind;
+    }
 };
 
 MRDOCS_DECL
@@ -98,7 +212,7 @@ struct LocationEmptyPredicate
     constexpr bool operator()(
         Location const& loc) const noexcept
     {
-        return loc.Filename.empty();
+        return loc.FileId == 0;
     }
 };
 
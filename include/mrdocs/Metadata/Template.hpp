@@ -16,6 +16,7 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/ADT/Optional.hpp>
 #include <mrdocs/Metadata/Type.hpp>
+#include <mrdocs/Support/ArenaAllocated.hpp>
 #include <mrdocs/Support/TypeTraits.hpp>
 #include <optional>
 #include <string>
@@ -47,6 +48,7 @@ tag_invoke(
 }
 
 struct TArg
+    : ArenaAllocated
 {
     /** The kind of template argument this is. */
     TArgKind Kind;
@@ -182,6 +184,7 @@ enum class TParamKind : int
 MRDOCS_DECL std::string_view toString(TParamKind kind) noexcept;
 
 struct TParam
+    : ArenaAllocated
 {
     /** The kind of template parameter this is */
     TParamKind Kind;
@@ -17,6 +17,7 @@
 #include <mrdocs/Metadata/Specifiers.hpp>
 #include <mrdocs/Metadata/Symbols.hpp>
 #include <mrdocs/MetadataFwd.hpp>
+#include <mrdocs/Support/ArenaAllocated.hpp>
 #include <mrdocs/Support/TypeTraits.hpp>
 #include <memory>
 #include <string>
@@ -97,6 +98,7 @@ tag_invoke(
     the type information according to the kind.
  */
 struct TypeInfo
+    : ArenaAllocated
 {
     /** The kind of TypeInfo this is
     */
@@ -0,0 +1,110 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_API_SUPPORT_ARENAALLOCATED_HPP
+#define MRDOCS_API_SUPPORT_ARENAALLOCATED_HPP
+
+#include <mrdocs/Platform.hpp>
+#include <compare>
+#include <cstddef>
+
+namespace clang {
+namespace mrdocs {
+
+class Arena;
+
+/** A base class for objects allocated from an arena.
+
+    The metadata is a tree of many small objects,
+    such as symbols, types, names, and javadoc
+    nodes. Objects of the classes derived from
+    this class which are created while an
+    @ref ArenaScope is active on the thread are
+    allocated from the large blocks of memory
+    of its arena instead of the heap.
+
+    An arena is released in bulk, when its scope
+    ended and all of its objects were destroyed.
+    The memory of a single destroyed object is
+    not reused, so an arena is only used for
+    objects which are kept together, such as
+    the metadata of a translation unit.
+
+    Objects created outside of a scope and
+    objects larger than the largest size
+    class are allocated from the heap.
+
+    The derived classes must have a virtual
+    destructor, so the size of the object
+    is known when it is destroyed.
+*/
+struct MRDOCS_DECL
+    ArenaAllocated
+{
+    /** Allocate memory for an object.
+    */
+    static
+    void*
+    operator new(std::size_t size);
+
+    /** Deallocate the memory of an object.
+    */
+    static
+    void
+    operator delete(
+        void* p,
+        std::size_t size) noexcept;
+
+    constexpr
+    auto
+    operator<=>(ArenaAllocated const&) const noexcept = default;
+};
+
+/** Allocate the objects created by a thread from a new arena.
+
+    While the scope is active, the objects derived
+    from @ref ArenaAllocated which are created by
+    the thread are allocated from an arena owned
+    by the scope and its objects. The objects may
+    be moved to other threads and destroyed by
+    them.
+
+    The arena is released when the scope ended
+    and its last object is destroyed, so the
+    memory of a translation unit is returned
+    with the corpus which owns its metadata.
+
+    Scopes can be nested, in which case the
+    previous scope is active again when the
+    inner scope ends.
+*/
+class MRDOCS_DECL
+    ArenaScope
+{
+    Arena* arena_;
+    Arena* prev_;
+
+public:
+    /** Constructor.
+    */
+    ArenaScope();
+
+    /** Destructor.
+    */
+    ~ArenaScope();
+
+    ArenaScope(ArenaScope const&) = delete;
+    ArenaScope& operator=(ArenaScope const&) = delete;
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -12,12 +12,17 @@
 #define MRDOCS_API_SUPPORT_GLOBPATTERN_HPP
 
 #include <mrdocs/Support/Error.hpp>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string_view>
+#include <vector>
 
 namespace clang::mrdocs {
 
+class GlobPatternSet;
+class SymbolGlobPatternSet;
+
 /** A glob pattern matcher
 
     @li "*" matches all characters except delimiters.
@@ -34,6 +39,8 @@ namespace clang::mrdocs {
 class GlobPattern {
     struct Impl;
     std::unique_ptr<Impl> impl_;
+
+    friend class GlobPatternSet;
 public:
     /** Constructs a GlobPattern with the given pattern.
 
@@ -203,6 +210,8 @@ public:
  */
 class SymbolGlobPattern {
     GlobPattern glob_;
+
+    friend class SymbolGlobPatternSet;
 public:
     /** Constructs a SymbolGlobPattern with the given pattern.
 
@@ -287,6 +296,224 @@ public:
     }
 };
 
+/** A set of glob patterns matched together
+
+    The literal prefixes of the patterns, which are
+    the characters before their first metacharacter,
+    are stored in a trie. Matching a string walks
+    the trie once, and only the patterns whose
+    literal prefix is a prefix of the string
+    match the rest of their pattern.
+
+    The result of every function is the same as
+    the result of the corresponding function of
+    @ref GlobPattern applied to each pattern.
+
+    Since qualified names often extend the name of
+    their parent, the state of the walk can be saved
+    and resumed with a longer string.
+ */
+class GlobPatternSet {
+    struct Impl;
+    std::shared_ptr<Impl const> impl_;
+public:
+    /** The state of a walk over a string.
+     */
+    class State {
+        friend class GlobPatternSet;
+
+        // The trie node reached
+        std::uint32_t node_ = 0;
+        // The number of characters walked
+        std::size_t size_ = 0;
+        // Whether every character walked is in the trie
+        bool inTrie_ = true;
+        // The patterns whose literal prefix was walked
+        std::vector<std::uint32_t> candidates_;
+    };
+
+    /** Construct an empty set.
+
+        An empty set never matches any string.
+     */
+    GlobPatternSet() = default;
+
+    /** Construct a set from a list of patterns.
+
+        @param patterns The patterns in the set.
+     */
+    explicit
+    GlobPatternSet(std::vector<GlobPattern> patterns);
+
+    /** Return true if the set has no patterns.
+     */
+    bool
+    empty() const noexcept;
+
+    /** Return the state before walking any characters.
+     */
+    State
+    start() const;
+
+    /** Walk the characters of a string.
+
+        The characters which were already walked
+        by the state are skipped, so `str` must
+        start with the string the state walked.
+
+        @param state The state to update.
+        @param str The string to walk.
+     */
+    void
+    advance(State& state, std::string_view str) const;
+
+    /** Matches a walked string against the patterns.
+
+        @param state The state after walking `str`.
+        @param str The string to match.
+        @return true if any pattern matches the string.
+     */
+    bool
+    match(State const& state, std::string_view str, char delimiter) const;
+
+    /** Matches the start of a walked string against the patterns.
+
+        @param state The state after walking `prefix`.
+        @param prefix The string to match.
+        @return true if the string prefix matches any pattern.
+     */
+    bool
+    matchPatternPrefix(State const& state, std::string_view prefix, char delimiter) const;
+
+    /** Matches the given string against the patterns.
+
+        @param str The string to match against the patterns.
+        @return true if any pattern matches the string.
+     */
+    bool
+    match(std::string_view const str, char const delimiter) const
+    {
+        State state = start();
+        advance(state, str);
+        return match(state, str, delimiter);
+    }
+
+    /** Matches the start of a given string against the patterns.
+
+        @param prefix The string to match against the patterns.
+        @return true if the string prefix matches any pattern.
+     */
+    bool
+    matchPatternPrefix(std::string_view const prefix, char const delimiter) const
+    {
+        State state = start();
+        advance(state, prefix);
+        return matchPatternPrefix(state, prefix, delimiter);
+    }
+};
+
+/** A set of glob patterns for C++ symbols
+
+    A @ref GlobPatternSet of @ref SymbolGlobPattern,
+    where "*" does not match "::".
+ */
+class SymbolGlobPatternSet {
+    GlobPatternSet set_;
+public:
+    /** The state of a walk over a symbol name.
+     */
+    using State = GlobPatternSet::State;
+
+    /** Construct an empty set.
+
+        An empty set never matches any string.
+     */
+    SymbolGlobPatternSet() = default;
+
+    /** Construct a set from a list of patterns.
+
+        @param patterns The patterns in the set.
+     */
+    explicit
+    SymbolGlobPatternSet(std::vector<SymbolGlobPattern> const& patterns)
+    {
+        std::vector<GlobPattern> globs;
+        globs.reserve(patterns.size());
+        for (SymbolGlobPattern const& pattern : patterns)
+        {
+            globs.push_back(pattern.glob_);
+        }
+        set_ = GlobPatternSet(std::move(globs));
+    }
+
+    /// @copydoc GlobPatternSet::empty
+    bool
+    empty() const noexcept
+    {
+        return set_.empty();
+    }
+
+    /// @copydoc GlobPatternSet::start
+    State
+    start() const
+    {
+        return set_.start();
+    }
+
+    /// @copydoc GlobPatternSet::advance
+    void
+    advance(State& state, std::string_view const str) const
+    {
+        set_.advance(state, str);
+    }
+
+    /** Matches a walked string against the patterns.
+
+        @param state The state after walking `str`.
+        @param str The string to match.
+        @return true if any pattern matches the string.
+     */
+    bool
+    match(State const& state, std::string_view const str) const
+    {
+        return set_.match(state, str, ':');
+    }
+
+    /** Matches the start of a walked string against the patterns.
+
+        @param state The state after walking `prefix`.
+        @param prefix The string to match.
+        @return true if the string prefix matches any pattern.
+     */
+    bool
+    matchPatternPrefix(State const& state, std::string_view const prefix) const
+    {
+        return set_.matchPatternPrefix(state, prefix, ':');
+    }
+
+    /** Matches the given string against the patterns.
+
+        @param str The string to match against the patterns.
+        @return true if any pattern matches the string.
+     */
+    bool
+    match(std::string_view const str) const
+    {
+        return set_.match(str, ':');
+    }
+
+    /** Matches the start of a given string against the patterns.
+
+        @param prefix The string to match against the patterns.
+        @return true if the string prefix matches any pattern.
+     */
+    bool
+    matchPatternPrefix(std::string_view const prefix) const
+    {
+        return set_.matchPatternPrefix(prefix, ':');
+    }
+};
+
 } // clang::mrdocs
 
 #endif // MRDOCS_API_SUPPORT_GLOBPATTERN_HPP
\ No newline at end of file
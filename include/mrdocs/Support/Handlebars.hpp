@@ -14,6 +14,7 @@
 #include <mrdocs/Support/String.hpp>
 #include <mrdocs/Dom.hpp>
 #include <string_view>
+#include <memory>
 #include <unordered_map>
 #include <functional>
 #include <type_traits>
@@ -484,11 +485,50 @@ namespace detail {
         }
     };
 
-    using partials_map = std::unordered_map<
-        std::string, std::string, string_hash, std::equal_to<>>;
-
     using partials_view_map = std::unordered_map<
         std::string, std::string_view, string_hash, std::equal_to<>>;
+
+    struct CompiledTemplate;
+}
+
+/** A compiled handlebars template
+
+    A compiled template holds the template text and
+    the tags parsed from it, including their helper
+    names, arguments, block parameters, and whitespace
+    control flags. Rendering a compiled template does
+    not parse these tags again.
+
+    Compiled templates are immutable. Copies share
+    the same compiled data and a template can be
+    rendered concurrently by multiple threads.
+
+    @see Handlebars::compile
+ */
+class MRDOCS_DECL HandlebarsTemplate
+{
+    friend class Handlebars;
+
+    std::shared_ptr<detail::CompiledTemplate const> impl_;
+
+    explicit
+    HandlebarsTemplate(
+        std::shared_ptr<detail::CompiledTemplate const> impl) noexcept;
+
+public:
+    /** Construct an empty template
+     */
+    HandlebarsTemplate() noexcept = default;
+
+    /** Return the template text
+     */
+    std::string_view
+    text() const noexcept;
+};
+
+namespace detail {
+    using partials_map = std::unordered_map<
+        std::string, HandlebarsTemplate, string_hash, std::equal_to<>>;
 }
 
 /** A handlebars environment
@@ -562,24 +602,18 @@ namespace detail {
 
     Compiled templates:
 
-    Unlike handlebars.js, this implementation renders the template
-    directly to the output stream, without requiring an intermediary
-    object to store a representation of the compiled template
-    (`Handlebars.precompile`) or an intermediary callable object
-    required to ultimately render the template (`Handlebars.precompile`).
+    Templates can be rendered directly from their text, in which case
+    the tags are parsed as the template is rendered, or compiled once
+    with `compile` and then rendered any number of times. Partials
+    are always compiled when they are registered.
 
-    The rationale is that there is not much benefit in pre-compiling templates
-    in C++, since both iterating the input string and a pre-compiled template
-    would have very similar costs even in optimal implementations of the
-    compiled template.
+    A compiled template stores the tags parsed from the template text.
+    The text itself is still used to render the template, so the same
+    rendering logic applies to both compiled and uncompiled templates.
+    Blocks and inline partials are rendered from the compiled tags of
+    the template containing them.
 
-    The most significant benefit of pre-compiling templates in C++ would
-    be the faster identification of the ends of blocks, which would
-    allow the engine iterate the block only once. For this reason,
-    compiled templates will still be considered in a future version
-    of this sub-library.
-
-    Also note that compiled templates cannot avoid exceptions, because
+    Note that compiled templates cannot avoid exceptions, because
     a compiled template can still invoke a helper that throws exceptions
     and evaluate dynamic expressions that cannot be identified during the
     first pass.
@@ -656,6 +690,21 @@ public:
      */
     Handlebars();
 
+    /** Compile a handlebars template
+
+        This function parses the tags of the template once, so
+        the template can be rendered many times without parsing
+        them again.
+
+        The template text is copied to the compiled template.
+
+        @param templateText The handlebars template text
+        @return The compiled template
+     */
+    static
+    HandlebarsTemplate
+    compile(std::string_view templateText);
+
     /** Render a handlebars template
 
         This function renders the specified handlebars template and
@@ -713,6 +762,21 @@ public:
         return *exp;
     }
 
+    /// @overload
+    std::string
+    render(
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context,
+        HandlebarsOptions const& options) const
+    {
+        auto exp = try_render(tmpl, context, options);
+        if (!exp)
+        {
+            throw exp.error();
+        }
+        return *exp;
+    }
+
     /** Render a handlebars template
 
         This function renders the specified handlebars template and
@@ -768,6 +832,21 @@ public:
         }
     }
 
+    /// @overload
+    void
+    render_to(
+        OutputRef& out,
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context,
+        HandlebarsOptions const& options) const
+    {
+        auto exp = try_render_to(out, tmpl, context, options);
+        if (!exp)
+        {
+            throw exp.error();
+        }
+    }
+
     /** @copydoc render_to(OutputRef&, std::string_view, dom::Value const&, HandlebarsOptions const&) const
      */
     Expected<std::string, HandlebarsError>
@@ -803,6 +882,23 @@ public:
         return try_render(templateText, context, {});
     }
 
+    /// @overload
+    Expected<std::string, HandlebarsError>
+    try_render(
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context,
+        HandlebarsOptions const& options) const
+    {
+        std::string out;
+        OutputRef os(out);
+        auto exp = try_render_to(os, tmpl, context, options);
+        if (!exp)
+        {
+            return Unexpected(exp.error());
+        }
+        return out;
+    }
+
     /** Render a handlebars template
 
         This function renders the specified handlebars template and
@@ -843,6 +939,14 @@ public:
         return try_render_to(out, templateText, context, {});
     }
 
+    /// @overload
+    Expected<void, HandlebarsError>
+    try_render_to(
+        OutputRef& out,
+        HandlebarsTemplate const& tmpl,
+        dom::Value const& context,
+        HandlebarsOptions const& options) const;
+
     /** Register a partial
 
         This function registers a partial with the handlebars environment.
@@ -866,6 +970,8 @@ public:
         </ul>
         @endcode
 
+        The partial is compiled when it is registered.
+
         @param name The name of the partial
         @param text The content of the partial
 
@@ -922,6 +1028,23 @@ public:
     void
     registerHelper(std::string_view name, dom::Function const& helper);
 
+    /** Find a registered helper
+
+        @param name The name of the helper
+        @return A pointer to the helper, or `nullptr` if no
+        helper is registered with this name.
+     */
+    dom::Function const*
+    findHelper(std::string_view name) const noexcept
+    {
+        auto it = helpers_.find(name);
+        if (it == helpers_.end())
+        {
+            return nullptr;
+        }
+        return &it->second;
+    }
+
     /** Unregister a helper
 
         This function unregisters a helper with the handlebars environment.
@@ -1033,7 +1156,8 @@ private:
     std::pair<std::string_view, bool>
     getPartial(
         std::string_view name,
-        detail::RenderState const& state) const;
+        detail::RenderState const& state,
+        detail::CompiledTemplate const*& compiled) const;
 };
 
 /** Determine if a value is empty
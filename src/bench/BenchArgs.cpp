@@ -0,0 +1,149 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "BenchArgs.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+BenchArgs BenchArgs::instance_;
+
+//------------------------------------------------
+
+BenchArgs::
+BenchArgs()
+    : usageText("MrDocs Benchmark Program")
+    , extraHelp(
+R"(
+Generates a synthetic C++ project, extracts its symbols, and
+generates its documentation with each generator. The escape
+functions of the generators are measured on the text of the
+headers. The measurements are written as JSON.
+
+EXAMPLES:
+    mrdocs-bench
+    mrdocs-bench --namespaces=32 --classes=64 --generator=xml
+    mrdocs-bench --doc-density=100 --output=results.json
+)")
+
+//
+// Synthetic project options
+//
+, namespaces(
+    "namespaces",
+    llvm::cl::desc("Number of namespaces, each declared in its own header."),
+    llvm::cl::init(8))
+
+, classes(
+    "classes",
+    llvm::cl::desc("Number of classes in each namespace."),
+    llvm::cl::init(16))
+
+, functions(
+    "functions",
+    llvm::cl::desc("Number of member function names in each class."),
+    llvm::cl::init(8))
+
+, overloads(
+    "overloads",
+    llvm::cl::desc("Number of overloads of each member function."),
+    llvm::cl::init(2))
+
+, templateDepth(
+    "template-depth",
+    llvm::cl::desc("Number of nested member class templates in each class."),
+    llvm::cl::init(1))
+
+, docDensity(
+    "doc-density",
+    llvm::cl::desc("Percentage of the declarations with a documentation comment."),
+    llvm::cl::init(50))
+
+, translationUnits(
+    "translation-units",
+    llvm::cl::desc("Number of translation units, each including every header."),
+    llvm::cl::init(4))
+
+//
+// Run options
+//
+, generators(
+    "generator",
+    llvm::cl::desc("Generators to measure. Defaults to xml, adoc, and html."),
+    llvm::cl::CommaSeparated)
+
+, addons(
+    "addons",
+    llvm::cl::desc("Path to the addons directory."),
+#ifdef MRDOCS_BENCH_ADDONS_DIR
+    llvm::cl::init(MRDOCS_BENCH_ADDONS_DIR)
+#else
+    llvm::cl::init("")
+#endif
+    )
+
+, concurrency(
+    "concurrency",
+    llvm::cl::desc("Number of threads to use: 0 for hardware-suggested."),
+    llvm::cl::init(0))
+
+, workDir(
+    "work-dir",
+    llvm::cl::desc("Directory where the project and the documentation are written. "
+                   "Defaults to a temporary directory, which is removed afterwards."),
+    llvm::cl::init(""))
+
+, output(
+    "output",
+    llvm::cl::desc("File where the results are written. Defaults to the standard output."),
+    llvm::cl::init(""))
+{
+}
+
+void
+BenchArgs::
+hideForeignOptions()
+{
+    // When adding an option, it must also be
+    // added to this list or else it will stay hidden.
+
+    std::vector<llvm::cl::Option const*> ours({
+        &namespaces,
+        &classes,
+        &functions,
+        &overloads,
+        &templateDepth,
+        &docDensity,
+        &translationUnits,
+        // llvm::cl::list overloads the address-of operator
+        std::addressof(generators),
+        &addons,
+        &concurrency,
+        &workDir,
+        &output
+    });
+
+    // Really hide the clang/llvm default
+    // options which we didn't ask for.
+    auto optionMap = llvm::cl::getRegisteredOptions();
+    for(auto& opt : optionMap)
+    {
+        if(std::find(ours.begin(), ours.end(), opt.getValue()) != ours.end())
+            opt.getValue()->setHiddenFlag(llvm::cl::NotHidden);
+        else
+            opt.getValue()->setHiddenFlag(llvm::cl::ReallyHidden);
+    }
+}
+
+} // mrdocs
+} // clang
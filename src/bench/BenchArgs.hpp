@@ -0,0 +1,62 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_BENCH_BENCHARGS_HPP
+#define MRDOCS_BENCH_BENCHARGS_HPP
+
+#include <llvm/Support/CommandLine.h>
+#include <string>
+
+namespace clang {
+namespace mrdocs {
+
+/** Command line options of the benchmark program.
+*/
+class BenchArgs
+{
+    BenchArgs();
+
+public:
+    static BenchArgs instance_;
+
+    char const*                     usageText;
+    llvm::cl::extrahelp             extraHelp;
+
+    // Synthetic project options
+    llvm::cl::opt<unsigned>         namespaces;
+    llvm::cl::opt<unsigned>         classes;
+    llvm::cl::opt<unsigned>         functions;
+    llvm::cl::opt<unsigned>         overloads;
+    llvm::cl::opt<unsigned>         templateDepth;
+    llvm::cl::opt<unsigned>         docDensity;
+    llvm::cl::opt<unsigned>         translationUnits;
+
+    // Run options
+    llvm::cl::list<std::string>     generators;
+    llvm::cl::opt<std::string>      addons;
+    llvm::cl::opt<unsigned>         concurrency;
+    llvm::cl::opt<std::string>      workDir;
+    llvm::cl::opt<std::string>      output;
+
+    // Hide all options that don't belong to us
+    void hideForeignOptions();
+};
+
+/** Command line arguments passed to the benchmark.
+
+    This is a global variable because of how the
+    LLVM command line interface is designed.
+*/
+constexpr static BenchArgs& benchArgs = BenchArgs::instance_;
+
+} // mrdocs
+} // clang
+
+#endif
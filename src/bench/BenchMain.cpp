@@ -0,0 +1,427 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "BenchArgs.hpp"
+#include "SyntheticProject.hpp"
+#include "lib/Gen/adoc/AdocEscape.hpp"
+#include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Lib/CorpusImpl.hpp"
+#include "lib/Lib/MrDocsCompilationDatabase.hpp"
+#include "lib/Support/Path.hpp"
+#include "lib/Support/Trace.hpp"
+#include <mrdocs/Generators.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/Handlebars.hpp>
+#include <mrdocs/Support/Path.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <mrdocs/Version.hpp>
+#include <clang/Tooling/JSONCompilationDatabase.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/PrettyStackTrace.h>
+#include <llvm/Support/Signals.h>
+#include <llvm/Support/raw_ostream.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#   include <psapi.h>
+#else
+#   include <sys/resource.h>
+#endif
+
+int main(int argc, char const** argv);
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double
+seconds(clock_type::duration d) noexcept
+{
+    return std::chrono::duration<double>(d).count();
+}
+
+double
+seconds(std::chrono::microseconds d) noexcept
+{
+    return std::chrono::duration<double>(d).count();
+}
+
+double
+perSecond(std::size_t n, double s) noexcept
+{
+    return s > 0 ? static_cast<double>(n) / s : 0;
+}
+
+// Return the peak resident set size of the process in bytes
+std::uint64_t
+peakRSS() noexcept
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    {
+        return pmc.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#   ifdef __APPLE__
+    // bytes
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#   else
+    // kilobytes
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#   endif
+#endif
+}
+
+// Return the number of files in a directory and its subdirectories
+std::size_t
+countFiles(std::string const& dir)
+{
+    namespace fs = llvm::sys::fs;
+    std::size_t n = 0;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(dir, ec), end;
+         it != end && !ec; it.increment(ec))
+    {
+        if (it->type() == fs::file_type::regular_file)
+        {
+            ++n;
+        }
+    }
+    return n;
+}
+
+// Return the contents of the files in a directory,
+// repeated until they are at least a mebibyte
+std::string
+escapeText(std::string const& dir)
+{
+    namespace fs = llvm::sys::fs;
+    std::string files;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end;
+         it != end && !ec; it.increment(ec))
+    {
+        if (auto buffer = llvm::MemoryBuffer::getFile(it->path()))
+        {
+            files.append((*buffer)->getBuffer());
+        }
+    }
+    std::string text;
+    while (!files.empty() && text.size() < (1 << 20))
+    {
+        text.append(files);
+    }
+    return text;
+}
+
+// Return the mebibytes per second written by
+// an escape function
+template <class Escape>
+double
+measureEscape(
+    Escape const& escape,
+    std::string_view const text)
+{
+    constexpr int runs = 4;
+    std::string res;
+    auto const start = clock_type::now();
+    for (int i = 0; i < runs; ++i)
+    {
+        res.clear();
+        OutputRef out(res);
+        escape(out, text);
+    }
+    double const s = seconds(clock_type::now() - start);
+    return perSecond(runs * text.size(), s) / (1 << 20);
+}
+
+struct GeneratorResult
+{
+    std::string name;
+    double seconds = 0;
+    std::size_t pages = 0;
+};
+
+Expected<void>
+DoBenchAction(std::string const& execPath)
+{
+    // --------------------------------------------------------------
+    //
+    // Generate the synthetic project
+    //
+    // --------------------------------------------------------------
+    SyntheticProjectOptions opts;
+    opts.namespaces = benchArgs.namespaces;
+    opts.classes = benchArgs.classes;
+    opts.functions = benchArgs.functions;
+    opts.overloads = benchArgs.overloads;
+    opts.templateDepth = benchArgs.templateDepth;
+    opts.docDensity = benchArgs.docDensity;
+    opts.translationUnits = benchArgs.translationUnits;
+
+    std::optional<ScopedTempDirectory> tempDir;
+    std::string workDir = benchArgs.workDir;
+    if (workDir.empty())
+    {
+        tempDir.emplace("mrdocs-bench");
+        MRDOCS_CHECK(*tempDir, "Failed to create a temporary directory");
+        workDir = std::string(tempDir->path());
+    }
+    else
+    {
+        MRDOCS_TRY(workDir, files::makeAbsolute(workDir));
+    }
+    workDir = files::makePosixStyle(workDir);
+    MRDOCS_TRY(
+        SyntheticProject project,
+        SyntheticProject::generate(opts, workDir));
+
+    // --------------------------------------------------------------
+    //
+    // Load configuration
+    //
+    // --------------------------------------------------------------
+    ReferenceDirectories dirs;
+    dirs.cwd = workDir;
+    dirs.mrdocsRoot = files::getParentDir(execPath, 2);
+    Config::Settings settings;
+    MRDOCS_TRY(Config::Settings::load_file(settings, project.configPath, dirs));
+    settings.addons = benchArgs.addons;
+    settings.concurrency = benchArgs.concurrency;
+    MRDOCS_TRY(settings.normalize(dirs));
+    ThreadPool threadPool(settings.concurrency);
+    MRDOCS_TRY(
+        std::shared_ptr<ConfigImpl const> config,
+        ConfigImpl::load(settings, dirs, threadPool));
+
+    std::string errorMessage;
+    std::unique_ptr<tooling::JSONCompilationDatabase> jsonDatabase =
+        tooling::JSONCompilationDatabase::loadFromFile(
+            project.compileCommandsPath,
+            errorMessage,
+            tooling::JSONCommandLineSyntax::AutoDetect);
+    MRDOCS_CHECK(jsonDatabase, formatError(
+        "Failed to load compilation database: {}", errorMessage));
+    std::unordered_map<std::string, std::vector<std::string>> defaultIncludePaths;
+    MrDocsCompilationDatabase compilations(
+        workDir, *jsonDatabase, config, defaultIncludePaths);
+
+    // --------------------------------------------------------------
+    //
+    // Build the corpus
+    //
+    // --------------------------------------------------------------
+    // The phases are measured with the spans
+    // recorded by the trace
+    trace::start();
+    auto start = clock_type::now();
+    MRDOCS_TRY(
+        std::unique_ptr<Corpus> corpus,
+        CorpusImpl::build(config, compilations));
+    double const extractSeconds = seconds(clock_type::now() - start);
+
+    // Read the phases before generating the documentation,
+    // so the spans of the generators are not kept in memory
+    // while their throughput and memory use are measured
+    constexpr char const* phaseNames[] = {
+        "Parse", "Visit AST", "Report results", "Wait for merge",
+        "Build lookup tables", "Finalize", "Build name table" };
+    std::vector<std::pair<char const*, double>> phases;
+    for (char const* phase : phaseNames)
+    {
+        phases.emplace_back(phase, seconds(trace::total(phase)));
+    }
+    trace::reset();
+
+    // --------------------------------------------------------------
+    //
+    // Generate the documentation
+    //
+    // --------------------------------------------------------------
+    std::vector<std::string> names(
+        benchArgs.generators.begin(), benchArgs.generators.end());
+    if (names.empty())
+    {
+        names = { "xml", "adoc", "html" };
+    }
+    std::vector<GeneratorResult> generated;
+    for (std::string const& name : names)
+    {
+        Generator const* generator = getGenerators().find(name);
+        MRDOCS_CHECK(generator, formatError(
+            "the Generator \"{}\" was not found", name));
+        std::string const outputDir = files::appendPath(workDir, "output", name);
+        MRDOCS_TRY(files::createDirectory(outputDir));
+        start = clock_type::now();
+        MRDOCS_TRY(generator->build(outputDir, *corpus));
+        generated.push_back({
+            name, seconds(clock_type::now() - start), countFiles(outputDir) });
+    }
+
+    // --------------------------------------------------------------
+    //
+    // Escape the text of the headers
+    //
+    // --------------------------------------------------------------
+    std::string const text = escapeText(
+        files::appendPath(workDir, "include", "bench"));
+    using EscapeFn = void (*)(OutputRef&, std::string_view);
+    double const htmlEscape = measureEscape(
+        static_cast<EscapeFn>(HTMLEscape), text);
+    double const adocEscape = measureEscape(
+        static_cast<EscapeFn>(adoc::AdocEscape), text);
+
+    // --------------------------------------------------------------
+    //
+    // Write the results
+    //
+    // --------------------------------------------------------------
+    std::string text;
+    llvm::raw_string_ostream os(text);
+    llvm::json::OStream J(os, 2);
+    J.object([&]
+    {
+        J.attribute("version", std::string(project_version));
+        J.attribute("threads", threadPool.getThreadCount());
+        J.attributeObject("project", [&]
+        {
+            J.attribute("namespaces", opts.namespaces);
+            J.attribute("classes", opts.classes);
+            J.attribute("functions", opts.functions);
+            J.attribute("overloads", opts.overloads);
+            J.attribute("template-depth", opts.templateDepth);
+            J.attribute("doc-density", opts.docDensity);
+            J.attribute("translation-units", opts.translationUnits);
+            J.attribute("declarations", static_cast<std::int64_t>(project.declarations));
+        });
+        J.attributeObject("extract", [&]
+        {
+            J.attribute("seconds", extractSeconds);
+            J.attribute("symbols", static_cast<std::int64_t>(corpus->size()));
+            J.attribute("symbols-per-second", perSecond(corpus->size(), extractSeconds));
+            // The spans of the translation units run concurrently,
+            // so their totals are the time spent by all threads
+            J.attributeObject("phases", [&]
+            {
+                for (auto const& [phase, s] : phases)
+                {
+                    J.attribute(phase, s);
+                }
+            });
+        });
+        J.attributeArray("generators", [&]
+        {
+            for (GeneratorResult const& r : generated)
+            {
+                J.object([&]
+                {
+                    J.attribute("name", r.name);
+                    J.attribute("seconds", r.seconds);
+                    J.attribute("pages", static_cast<std::int64_t>(r.pages));
+                    J.attribute("pages-per-second", perSecond(r.pages, r.seconds));
+                });
+            }
+        });
+        J.attributeObject("escape", [&]
+        {
+            J.attribute("html-mib-per-second", htmlEscape);
+            J.attribute("adoc-mib-per-second", adocEscape);
+        });
+        J.attribute("peak-rss-bytes", static_cast<std::int64_t>(peakRSS()));
+    });
+    os << '\n';
+    os.flush();
+
+    if (benchArgs.output.empty())
+    {
+        llvm::outs() << text;
+        return {};
+    }
+    std::error_code ec;
+    llvm::raw_fd_ostream out(benchArgs.output, ec, llvm::sys::fs::OF_None);
+    MRDOCS_CHECK(!ec, formatError(
+        "raw_fd_ostream(\"{}\") returned \"{}\"", benchArgs.output.getValue(), ec));
+    out << text;
+    return {};
+}
+
+int
+bench_main(int argc, char const** argv)
+{
+    llvm::EnablePrettyStackTrace();
+    llvm::sys::PrintStackTraceOnErrorSignal(argv[0]);
+
+    benchArgs.hideForeignOptions();
+    if (!llvm::cl::ParseCommandLineOptions(argc, argv, benchArgs.usageText))
+    {
+        return EXIT_FAILURE;
+    }
+
+    // Only the results are written to the standard output
+    report::setMinimumLevel(report::Level::error);
+    report::setSourceLocationWarnings(false);
+
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+// error: ISO C++ forbids taking address of function ‘::main’
+#endif
+    void* addressOfMain = reinterpret_cast<void*>(&main);
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+    std::string execPath = llvm::sys::fs::getMainExecutable(argv[0], addressOfMain);
+
+    if (auto exp = DoBenchAction(execPath); !exp)
+    {
+        report::error("Benchmark failed: {}", exp.error());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // (anon)
+
+} // mrdocs
+} // clang
+
+int main(int argc, char const** argv)
+{
+    try
+    {
+        return clang::mrdocs::bench_main(argc, argv);
+    }
+    catch(std::exception const& ex)
+    {
+        clang::mrdocs::report::error("Unhandled exception: {}\n", ex.what());
+    }
+    return EXIT_FAILURE;
+}
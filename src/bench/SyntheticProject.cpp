@@ -0,0 +1,283 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "SyntheticProject.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+#include <fmt/format.h>
+#include <iterator>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+Expected<void>
+writeFile(
+    std::string const& path,
+    std::string_view contents)
+{
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_None);
+    MRDOCS_CHECK(!ec, formatError(
+        "raw_fd_ostream(\"{}\") returned \"{}\"", path, ec));
+    os << contents;
+    os.close();
+    MRDOCS_CHECK(!os.has_error(), formatError(
+        "writing \"{}\" returned \"{}\"", path, os.error()));
+    return {};
+}
+
+// Writes the declarations of a header and
+// decides which of them are documented
+class HeaderWriter
+{
+    SyntheticProjectOptions const& opts_;
+    std::string& out_;
+    std::size_t declarations_ = 0;
+
+    static constexpr std::string_view paramTypes[] = {
+        "int", "double", "char const*", "long", "bool", "unsigned"
+    };
+
+public:
+    HeaderWriter(
+        SyntheticProjectOptions const& opts,
+        std::string& out)
+        : opts_(opts)
+        , out_(out)
+    {
+    }
+
+    std::size_t
+    declarations() const noexcept
+    {
+        return declarations_;
+    }
+
+    // Write the documentation of the next declaration,
+    // if it is one of the documented ones. Multiplying
+    // by a number coprime with 100 spreads the documented
+    // declarations evenly.
+    template <class... Args>
+    void
+    doc(
+        std::string_view indent,
+        fmt::format_string<Args...> brief,
+        Args&&... args)
+    {
+        std::size_t const n = declarations_++;
+        if ((n * 37) % 100 >= opts_.docDensity)
+        {
+            return;
+        }
+        fmt::format_to(std::back_inserter(out_), "{}/** ", indent);
+        fmt::format_to(std::back_inserter(out_), brief, std::forward<Args>(args)...);
+        fmt::format_to(std::back_inserter(out_),
+            "\n\n{0}    This declaration is generated to measure\n"
+            "{0}    the extraction of the documentation.\n"
+            "{0}*/\n", indent);
+    }
+
+    void
+    function(
+        std::string_view indent,
+        unsigned const k,
+        unsigned const o)
+    {
+        doc(indent, "Function {}, overload {}", k, o);
+        fmt::format_to(std::back_inserter(out_), "{}int f{}(", indent, k);
+        for (unsigned p = 0; p <= o; ++p)
+        {
+            fmt::format_to(std::back_inserter(out_), "{}{} a{}",
+                p == 0 ? "" : ", ",
+                paramTypes[p % std::size(paramTypes)], p);
+        }
+        out_ += ");\n\n";
+    }
+
+    void
+    nested(
+        std::string indent,
+        unsigned const depth)
+    {
+        if (depth > opts_.templateDepth)
+        {
+            return;
+        }
+        doc(indent, "Nested template {}", depth);
+        fmt::format_to(std::back_inserter(out_),
+            "{0}template <class T{1}>\n"
+            "{0}struct N{1}\n"
+            "{0}{{\n", indent, depth);
+        indent += "    ";
+        doc(indent, "Return a value");
+        fmt::format_to(std::back_inserter(out_),
+            "{}T{} get() const;\n\n", indent, depth);
+        nested(indent, depth + 1);
+        indent.resize(indent.size() - 4);
+        fmt::format_to(std::back_inserter(out_), "{}}};\n\n", indent);
+    }
+
+    void
+    header(unsigned const i)
+    {
+        fmt::format_to(std::back_inserter(out_),
+            "#ifndef BENCH_NS{0}_HPP\n"
+            "#define BENCH_NS{0}_HPP\n\n", i);
+        if (i != 0)
+        {
+            fmt::format_to(std::back_inserter(out_),
+                "#include <bench/ns{}.hpp>\n\n", i - 1);
+        }
+        fmt::format_to(std::back_inserter(out_),
+            "namespace bench {{\n"
+            "namespace ns{} {{\n\n", i);
+        for (unsigned j = 0; j < opts_.classes; ++j)
+        {
+            doc("", "Class {} of namespace {}", j, i);
+            fmt::format_to(std::back_inserter(out_),
+                "class C{}\n"
+                "{{\n"
+                "public:\n", j);
+            doc("    ", "Constructor");
+            fmt::format_to(std::back_inserter(out_), "    C{}();\n\n", j);
+            for (unsigned k = 0; k < opts_.functions; ++k)
+            {
+                for (unsigned o = 0; o < opts_.overloads; ++o)
+                {
+                    function("    ", k, o);
+                }
+            }
+            nested("    ", 1);
+            out_ += "};\n\n";
+
+            // The classes of a namespace refer to
+            // the classes of the previous one
+            doc("", "Make an object of class {}", j);
+            if (i != 0)
+            {
+                fmt::format_to(std::back_inserter(out_),
+                    "C{0} make(ns{1}::C{0} const& other);\n\n", j, i - 1);
+            }
+            else
+            {
+                fmt::format_to(std::back_inserter(out_),
+                    "C{0} make(C{0} const& other);\n\n", j);
+            }
+        }
+        fmt::format_to(std::back_inserter(out_),
+            "}} // ns{}\n"
+            "}} // bench\n\n"
+            "#endif\n", i);
+    }
+};
+
+} // (anon)
+
+Expected<SyntheticProject>
+SyntheticProject::
+generate(
+    SyntheticProjectOptions const& opts,
+    std::string_view const dir)
+{
+    MRDOCS_CHECK(opts.namespaces != 0, "The project has no namespaces");
+    MRDOCS_CHECK(opts.translationUnits != 0, "The project has no translation units");
+
+    SyntheticProject project;
+    std::string const includeDir = files::appendPath(dir, "include");
+    std::string const headerDir = files::appendPath(includeDir, "bench");
+    std::string const sourceDir = files::appendPath(dir, "src");
+    MRDOCS_TRY(files::createDirectory(headerDir));
+    MRDOCS_TRY(files::createDirectory(sourceDir));
+
+    // Headers
+    for (unsigned i = 0; i < opts.namespaces; ++i)
+    {
+        std::string text;
+        HeaderWriter writer(opts, text);
+        writer.header(i);
+        project.declarations += writer.declarations();
+        MRDOCS_TRY(writeFile(
+            files::appendPath(headerDir, fmt::format("ns{}.hpp", i)),
+            text));
+    }
+
+    // Translation units, which include every header
+    // and define the constructors of some classes
+    std::vector<std::string> sources;
+    for (unsigned t = 0; t < opts.translationUnits; ++t)
+    {
+        std::string text;
+        for (unsigned i = 0; i < opts.namespaces; ++i)
+        {
+            fmt::format_to(std::back_inserter(text),
+                "#include <bench/ns{}.hpp>\n", i);
+        }
+        text += '\n';
+        for (unsigned i = 0; i < opts.namespaces; ++i)
+        {
+            for (unsigned j = t; j < opts.classes; j += opts.translationUnits)
+            {
+                fmt::format_to(std::back_inserter(text),
+                    "bench::ns{0}::C{1}::C{1}() = default;\n", i, j);
+            }
+        }
+        std::string path = files::appendPath(sourceDir, fmt::format("tu{}.cpp", t));
+        MRDOCS_TRY(writeFile(path, text));
+        sources.push_back(std::move(path));
+    }
+
+    // Compilation database
+    {
+        std::string text;
+        llvm::raw_string_ostream os(text);
+        llvm::json::OStream J(os, 2);
+        J.array([&]
+        {
+            for (std::string const& source : sources)
+            {
+                J.object([&]
+                {
+                    J.attribute("directory", std::string(dir));
+                    J.attribute("file", source);
+                    J.attributeArray("arguments", [&]
+                    {
+                        J.value("clang++");
+                        J.value("-std=c++20");
+                        J.value("-I" + includeDir);
+                        J.value("-c");
+                        J.value(source);
+                    });
+                });
+            }
+        });
+        os.flush();
+        project.compileCommandsPath = files::appendPath(dir, "compile_commands.json");
+        MRDOCS_TRY(writeFile(project.compileCommandsPath, text));
+    }
+
+    // Configuration
+    project.configPath = files::appendPath(dir, "mrdocs.yml");
+    MRDOCS_TRY(writeFile(project.configPath,
+        "source-root: .\n"
+        "input:\n"
+        "  - include\n"
+        "compilation-database: compile_commands.json\n"
+        "multipage: true\n"));
+
+    return project;
+}
+
+} // mrdocs
+} // clang
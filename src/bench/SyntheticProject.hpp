@@ -0,0 +1,94 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_BENCH_SYNTHETICPROJECT_HPP
+#define MRDOCS_BENCH_SYNTHETICPROJECT_HPP
+
+#include <mrdocs/Support/Error.hpp>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace clang {
+namespace mrdocs {
+
+/** The parameters of a synthetic project.
+*/
+struct SyntheticProjectOptions
+{
+    /** Number of namespaces, each declared in its own header
+    */
+    unsigned namespaces = 8;
+
+    /** Number of classes in each namespace
+    */
+    unsigned classes = 16;
+
+    /** Number of member function names in each class
+    */
+    unsigned functions = 8;
+
+    /** Number of overloads of each member function
+    */
+    unsigned overloads = 2;
+
+    /** Number of nested member class templates in each class
+    */
+    unsigned templateDepth = 1;
+
+    /** Percentage of the declarations with a documentation comment
+    */
+    unsigned docDensity = 50;
+
+    /** Number of translation units, each including every header
+    */
+    unsigned translationUnits = 4;
+};
+
+/** A synthetic C++ project used to measure MrDocs.
+
+    The project is a set of headers declaring
+    namespaces of classes, a set of translation
+    units including them, a compilation database,
+    and a configuration file. The contents only
+    depend on the options, so runs with the same
+    options measure the same work.
+*/
+struct SyntheticProject
+{
+    /** The path of the configuration file
+    */
+    std::string configPath;
+
+    /** The path of the compilation database
+    */
+    std::string compileCommandsPath;
+
+    /** The number of declarations in the headers
+    */
+    std::size_t declarations = 0;
+
+    /** Write a synthetic project to a directory.
+
+        @param opts The parameters of the project.
+        @param dir The directory where the project
+        is written, which is created if needed.
+    */
+    static
+    Expected<SyntheticProject>
+    generate(
+        SyntheticProjectOptions const& opts,
+        std::string_view dir);
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -13,6 +13,7 @@
 
 #include "lib/AST/ASTAction.hpp"
 #include "lib/AST/ASTVisitorConsumer.hpp"
+#include "lib/Support/Trace.hpp"
 #include <clang/Frontend/CompilerInstance.h>
 #include <clang/Parse/ParseAST.h>
 
@@ -39,6 +40,10 @@ ExecuteAction()
         CI.createSema(getTranslationUnitKind(), nullptr);
     }
 
+    // The AST is visited when the parser reaches
+    // the end of the translation unit, so the
+    // visit is nested in this span
+    trace::Span span("Parse", getCurrentFile());
     ParseAST(
         CI.getSema(),
         false, // ShowStats
@@ -22,6 +22,7 @@
 #include "lib/Lib/Diagnostics.hpp"
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Support/ScopeExit.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
 #include <clang/AST/AST.h>
 #include <clang/AST/Attr.h>
 #include <clang/AST/ODRHash.h>
@@ -36,7 +37,9 @@
 #include <llvm/Support/Error.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/SHA1.h>
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <ranges>
 #include <unordered_set>
@@ -118,11 +121,13 @@ ASTVisitor::FileInfo::build(
 ASTVisitor::
 ASTVisitor(
     const ConfigImpl& config,
+    ExecutionContext& ex,
     Diagnostics& diags,
     CompilerInstance& compiler,
     ASTContext& context,
     Sema& sema) noexcept
     : config_(config)
+    , ex_(ex)
     , diags_(diags)
     , compiler_(compiler)
     , context_(context)
@@ -213,6 +218,7 @@ build()
     auto* TU = context_.getTranslationUnitDecl();
     traverse(TU);
     MRDOCS_ASSERT(find(SymbolID::global));
+    buildJavadoc();
 }
 
 template <
@@ -253,6 +259,16 @@ traverse(DeclTy* D)
         MRDOCS_CHECK_OR(exp, nullptr);
         auto& [I, isNew] = *exp;
 
+        // If another translation unit already extracted this
+        // definition, we only need the parent of the symbol.
+        // All other information is merged from the results
+        // of the other translation unit.
+        if (isNew && isExtractedElsewhere(I, D))
+        {
+            traverseParents(I, D);
+            return &I;
+        }
+
         // Populate the base classes with the necessary information.
         // Even when the object is new, we want to update the source locations
         // and the documentation status.
@@ -270,6 +286,9 @@ traverse(DeclTy* D)
         // Traverse the parents of the declaration in dependency mode.
         traverseParents(I, D);
 
+        // Let other translation units skip this definition.
+        markExtracted(I, D);
+
         return &I;
     }
     return nullptr;
@@ -322,6 +341,61 @@ traverse(IndirectFieldDecl* D)
     return traverse(D->getAnonField());
 }
 
+template <
+    std::derived_from<Info> InfoTy,
+    std::derived_from<Decl> DeclTy>
+bool
+ASTVisitor::
+isExtractedElsewhere(InfoTy& I, DeclTy* D)
+{
+    // Dependencies are not completely extracted,
+    // so there is nothing to skip
+    MRDOCS_CHECK_OR(I.Extraction != ExtractionMode::Dependency, false);
+    MRDOCS_CHECK_OR(isSharedDefinition(D), false);
+    std::optional<ExtractionMode> mode = ex_.findExtracted(I.id);
+    MRDOCS_CHECK_OR(mode, false);
+    I.Extraction = *mode;
+    return true;
+}
+
+template <
+    std::derived_from<Info> InfoTy,
+    std::derived_from<Decl> DeclTy>
+void
+ASTVisitor::
+markExtracted(InfoTy const& I, DeclTy* D)
+{
+    MRDOCS_CHECK_OR(I.Extraction != ExtractionMode::Dependency);
+    MRDOCS_CHECK_OR(isSharedDefinition(D));
+    ex_.markExtracted(I.id, I.Extraction);
+}
+
+bool
+ASTVisitor::
+isSharedDefinition(Decl const* D)
+{
+    // A class template is a definition when
+    // its templated declaration is
+    if (auto const* CTD = dyn_cast<ClassTemplateDecl>(D))
+    {
+        D = CTD->getTemplatedDecl();
+    }
+    auto const* TD = dyn_cast_if_present<TagDecl>(D);
+    MRDOCS_CHECK_OR(TD && TD->isThisDeclarationADefinition(), false);
+
+    // Implicit instantiations depend on the template
+    // arguments used in each translation unit
+    if (auto const* CTSD = dyn_cast<ClassTemplateSpecializationDecl>(TD))
+    {
+        MRDOCS_CHECK_OR(CTSD->isExplicitSpecialization(), false);
+    }
+
+    // Local classes and classes in anonymous namespaces
+    // are different entities in each translation unit
+    MRDOCS_CHECK_OR(TD->isExternallyVisible(), false);
+    return true;
+}
+
 template <
     std::derived_from<Info> InfoTy,
     std::derived_from<Decl> DeclTy>
@@ -674,8 +748,15 @@ populateInfoBases(InfoTy& I, bool const isNew, DeclTy* D)
         I.Extraction == ExtractionMode::Dependency)
     {
         // Try an exact match here
-        auto qualifiedName = this->qualifiedName(D);
-        if (checkSymbolFiltersImpl<false>(std::string_view(qualifiedName.str())))
+        bool const passesFilters = [&]
+        {
+            if (auto const* ND = dyn_cast<NamedDecl>(D))
+            {
+                return checkSymbolFilters(ND, false);
+            }
+            return checkSymbolFilters(std::string_view(), false);
+        }();
+        if (passesFilters)
         {
             I.Extraction = ExtractionMode::Regular;
             // default mode also becomes regular for its
@@ -821,6 +902,11 @@ populate(
         loc, false).getLine();
     FileInfo* file = findFileInfo(loc);
     MRDOCS_ASSERT(file);
+    if (file->id == 0)
+    {
+        file->id = FileTable::instance().add(
+            file->full_path, file->short_path, file->kind);
+    }
 
     if (definition)
     {
@@ -828,9 +914,7 @@ populate(
         {
             return;
         }
-        I.DefLoc.emplace(file->full_path,
-            file->short_path, line, file->kind,
-            documented);
+        I.DefLoc.emplace(file->id, line, documented);
     }
     else
     {
@@ -839,15 +923,13 @@ populate(
             [line, file](const Location& l)
             {
                 return l.LineNumber == line &&
-                    l.Path == file->full_path;
+                    l.FileId == file->id;
             });
         if (existing != I.Loc.end())
         {
             return;
         }
-        I.Loc.emplace_back(file->full_path,
-            file->short_path, line, file->kind,
-            documented);
+        I.Loc.emplace_back(file->id, line, documented);
     }
 }
 
@@ -1759,10 +1841,74 @@ generateJavadoc(
     // to be before and preprocessor directives, or submit a patch
     // which disables this behavior (it's not entirely clear why
     // this check occurs anyways, so some investigation is needed)
+    if (config_->parallelJavadoc)
+    {
+        // The declaration information of the comment
+        // is computed on demand, so it is computed here
+        // before the comment is converted by another thread
+        FC->getDeclInfo();
+        javadocTasks_.push_back({ &javadoc, FC, D });
+        return true;
+    }
     parseJavadoc(javadoc, FC, D, config_, diags_);
     return true;
 }
 
+void
+ASTVisitor::
+buildJavadoc()
+{
+    MRDOCS_CHECK_OR(!javadocTasks_.empty());
+
+    // Group the comments of each symbol,
+    // preserving the order of the comments
+    std::ranges::stable_sort(javadocTasks_,
+        std::less<>(), &JavadocTask::javadoc);
+    std::vector<std::size_t> groups;
+    for (std::size_t i = 0; i < javadocTasks_.size(); ++i)
+    {
+        if (i == 0 ||
+            javadocTasks_[i].javadoc != javadocTasks_[i - 1].javadoc)
+        {
+            groups.push_back(i);
+        }
+    }
+    groups.push_back(javadocTasks_.size());
+
+    ThreadPool& threadPool = config_.threadPool();
+    std::size_t const nGroups = groups.size() - 1;
+    std::size_t const n = std::min<std::size_t>(
+        nGroups, threadPool.getThreadCount() * 4);
+    std::vector<Diagnostics> diags(n);
+    std::mutex sourceMutex;
+    TaskGroup taskGroup(threadPool);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        taskGroup.async([&, i]
+        {
+            std::size_t const first = groups[nGroups * i / n];
+            std::size_t const last = groups[nGroups * (i + 1) / n];
+            for (std::size_t j = first; j < last; ++j)
+            {
+                JavadocTask const& task = javadocTasks_[j];
+                parseJavadoc(
+                    *task.javadoc, task.comment, task.decl,
+                    config_, diags[i], &sourceMutex);
+            }
+        });
+    }
+    auto errors = taskGroup.wait();
+    for (Diagnostics& d : diags)
+    {
+        diags_.merge(std::move(d));
+    }
+    javadocTasks_.clear();
+    if (!errors.empty())
+    {
+        Error(errors).Throw();
+    }
+}
+
 std::unique_ptr<TypeInfo>
 ASTVisitor::
 toTypeInfo(QualType const qt)
@@ -2592,66 +2738,127 @@ bool
 ASTVisitor::
 checkSymbolFilters(NamedDecl const* ND, bool const isScope) const
 {
-    SmallString<256> const name = qualifiedName(ND);
-    return checkSymbolFilters(name.str(), isScope);
+    MRDOCS_CHECK_OR(
+        !config_->includeSymbolSet.empty() ||
+        !config_->excludeSymbolSet.empty(), true);
+
+    // The result for a declaration context is
+    // stored with the state of its members
+    if (auto const* DC = dyn_cast<DeclContext>(ND))
+    {
+        SymbolFilterState& state = symbolFilterState(DC);
+        std::optional<bool>& passesFilters = state.passesFilters[isScope];
+        if (!passesFilters)
+        {
+            passesFilters = checkSymbolFilters(state, isScope);
+        }
+        return *passesFilters;
+    }
+    return checkSymbolFilters(makeSymbolFilterState(ND), isScope);
 }
 
 bool
 ASTVisitor::
 checkSymbolFilters(std::string_view const symbolName, bool const isScope) const
 {
-    if (isScope)
-    {
-        return checkSymbolFiltersImpl<true>(symbolName);
-    }
-    return checkSymbolFiltersImpl<false>(symbolName);
+    SymbolFilterState state;
+    state.name = symbolName;
+    state.include = config_->includeSymbolSet.start();
+    config_->includeSymbolSet.advance(state.include, state.name);
+    state.exclude = config_->excludeSymbolSet.start();
+    config_->excludeSymbolSet.advance(state.exclude, state.name);
+    return checkSymbolFilters(state, isScope);
 }
 
-template <bool isScope>
 bool
 ASTVisitor::
-checkSymbolFiltersImpl(std::string_view const symbolName) const
+checkSymbolFilters(SymbolFilterState const& state, bool const isScope) const
 {
     // Don't extract declarations that fail the symbol filter
-    auto includeMatchFn = [&](SymbolGlobPattern const& pattern)
+    auto const& include = config_->includeSymbolSet;
+    if (isScope)
     {
-        if constexpr (isScope)
-        {
-            // If the symbol is a scope, such as a namespace or class,
-            // we want to know if symbols in that scope might match
-            // the filters rather than the scope symbol itself.
-            // Because if symbols in that scope match the filter, we also
-            // want to extract the scope itself.
-            // Thus, we only need to show we might potentially match one
-            // of the prefixes of the symbol patterns, not the entire
-            // symbol pattern for the escope.
-            return pattern.matchPatternPrefix(symbolName);
-        }
-        else
-        {
-            return pattern.match(symbolName);
-        }
-    };
-    MRDOCS_CHECK_OR(
-        config_->includeSymbols.empty() ||
-        std::ranges::any_of(config_->includeSymbols, includeMatchFn), false);
-
-    // Don't extract declarations that fail the exclude symbol filter
-    auto excludeMatchFn = [&](SymbolGlobPattern const& pattern)
+        // If the symbol is a scope, such as a namespace or class,
+        // we want to know if symbols in that scope might match
+        // the filters rather than the scope symbol itself.
+        // Because if symbols in that scope match the filter, we also
+        // want to extract the scope itself.
+        // Thus, we only need to show we might potentially match one
+        // of the prefixes of the symbol patterns, not the entire
+        // symbol pattern for the escope.
+        MRDOCS_CHECK_OR(
+            include.empty() ||
+            include.matchPatternPrefix(state.include, state.name), false);
+    }
+    else
     {
-        // Unlike the include filter, we want to match the entire symbol name
-        // for the exclude filter regardless of whether the symbol is a scope.
-        // If the scope is explicitly excluded, we already know we want to
-        // exclude all symbols in that scope
-        return pattern.match(symbolName);
-    };
+        MRDOCS_CHECK_OR(
+            include.empty() ||
+            include.match(state.include, state.name), false);
+    }
+
+    // Don't extract declarations that fail the exclude symbol filter.
+    // Unlike the include filter, we want to match the entire symbol name
+    // for the exclude filter regardless of whether the symbol is a scope.
+    // If the scope is explicitly excluded, we already know we want to
+    // exclude all symbols in that scope
+    auto const& exclude = config_->excludeSymbolSet;
     MRDOCS_CHECK_OR(
-        config_->excludeSymbols.empty() ||
-        std::ranges::none_of(config_->excludeSymbols, excludeMatchFn), false);
+        exclude.empty() ||
+        !exclude.match(state.exclude, state.name), false);
 
     return true;
 }
 
+ASTVisitor::SymbolFilterState&
+ASTVisitor::
+symbolFilterState(DeclContext const* DC) const
+{
+    DC = DC->getPrimaryContext();
+    if (auto const it = symbolFilters_.find(DC);
+        it != symbolFilters_.end())
+    {
+        return it->second;
+    }
+    SymbolFilterState state = makeSymbolFilterState(cast<NamedDecl>(DC));
+    return symbolFilters_.try_emplace(DC, std::move(state)).first->second;
+}
+
+ASTVisitor::SymbolFilterState
+ASTVisitor::
+makeSymbolFilterState(NamedDecl const* ND) const
+{
+    auto const& include = config_->includeSymbolSet;
+    auto const& exclude = config_->excludeSymbolSet;
+
+    SymbolFilterState state;
+    state.name = qualifiedName(ND).str();
+
+    // Resume the walk of the parent when the qualified
+    // name extends the qualified name of the parent
+    SymbolFilterState const* parent = nullptr;
+    DeclContext const* P = ND->getDeclContext()->getRedeclContext();
+    if (isa<NamedDecl>(P))
+    {
+        parent = &symbolFilterState(P);
+    }
+    if (parent &&
+        state.name.starts_with(parent->name) &&
+        std::string_view(state.name).substr(parent->name.size()).starts_with("::"))
+    {
+        state.include = parent->include;
+        state.exclude = parent->exclude;
+    }
+    else
+    {
+        state.include = include.start();
+        state.exclude = exclude.start();
+    }
+    include.advance(state.include, state.name);
+    exclude.advance(state.exclude, state.name);
+    return state;
+}
+
 SmallString<256>
 ASTVisitor::
 qualifiedName(Decl const* D) const
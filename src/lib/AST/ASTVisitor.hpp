@@ -61,6 +61,9 @@ class ASTVisitor
     // MrDocs configuration
     ConfigImpl const& config_;
 
+    // The execution context shared by all translation units
+    ExecutionContext& ex_;
+
     // MrDocs diagnostics
     Diagnostics diags_;
 
@@ -79,6 +82,23 @@ class ASTVisitor
     // An unordered set of all extracted Info declarations
     InfoSet info_;
 
+    /* A documentation comment to convert after the traversal
+
+        When the `parallel-javadoc` option is set, the
+        comments are parsed during the traversal, and
+        converted by the thread pool once the AST is
+        no longer modified.
+     */
+    struct JavadocTask
+    {
+        std::unique_ptr<Javadoc>* javadoc;
+        comments::FullComment const* comment;
+        Decl const* decl;
+    };
+
+    // The comments to convert after the traversal
+    std::vector<JavadocTask> javadocTasks_;
+
     /* Struct to hold pre-processed file information.
 
         This struct stores information about a file, including its full path,
@@ -107,6 +127,10 @@ class ASTVisitor
 
         // Whether this file passes the file filters
         std::optional<bool> passesFilters;
+
+        // The ID of the file in the file table,
+        // added when the first location is populated.
+        std::uint32_t id = 0;
     };
 
     /*  A map of Clang FileEntry objects to Visitor FileInfo objects
@@ -125,6 +149,36 @@ class ASTVisitor
     */
     std::unordered_map<const FileEntry*, FileInfo> files_;
 
+    /* The state of the symbol filters for a qualified name
+
+        The walk over the qualified name of a declaration
+        context is stored so the symbol filters of its
+        members resume it instead of walking their
+        qualified names from the start.
+     */
+    struct SymbolFilterState
+    {
+        // The qualified name
+        std::string name;
+
+        // The walk of the include and exclude patterns
+        SymbolGlobPatternSet::State include;
+        SymbolGlobPatternSet::State exclude;
+
+        // Whether the symbol passes the filters,
+        // indexed by whether it is a scope
+        std::optional<bool> passesFilters[2];
+    };
+
+    /*  A map of declaration contexts to the state of the symbol filters
+
+        The map is keyed by the primary context, so
+        every redeclaration of a namespace or class
+        shares the same state.
+    */
+    mutable std::unordered_map<
+        DeclContext const*, SymbolFilterState> symbolFilters_;
+
     /* The current extraction mode
 
         This defines the extraction mode assigned to
@@ -171,6 +225,7 @@ public:
         translation unit.
 
         @param config The configuration object.
+        @param ex The execution context shared by all translation units.
         @param diags The diagnostics object.
         @param compiler The compiler instance.
         @param context The AST context.
@@ -178,6 +233,7 @@ public:
      */
     ASTVisitor(
         const ConfigImpl& config,
+        ExecutionContext& ex,
         Diagnostics& diags,
         CompilerInstance& compiler,
         ASTContext& context,
@@ -279,6 +335,47 @@ private:
     // AST Traversal Helpers
     // =================================================
 
+    /*  Determine if a definition was extracted by another translation unit
+
+        Definitions in headers are usually seen by many
+        translation units, and the Info each of them
+        extracts is merged into the same result.
+
+        If another translation unit has already extracted
+        the definition `D` and all of its members, this
+        function sets the extraction mode of `I` to the one
+        recorded by that translation unit and returns true.
+        The caller can then skip populating `I`, since the
+        merge step fills in the missing information.
+     */
+    template <
+        std::derived_from<Info> InfoTy,
+        std::derived_from<Decl> DeclTy>
+    bool
+    isExtractedElsewhere(InfoTy& I, DeclTy* D);
+
+    /*  Record that a definition was completely extracted
+
+        This lets other translation units skip the
+        definition with @ref isExtractedElsewhere.
+     */
+    template <
+        std::derived_from<Info> InfoTy,
+        std::derived_from<Decl> DeclTy>
+    void
+    markExtracted(InfoTy const& I, DeclTy* D);
+
+    /*  Determine if a declaration is a definition shared by all TUs
+
+        These are the definitions of externally visible
+        classes and enums, including class templates and
+        their explicit specializations. The ODR guarantees
+        they are the same in every translation unit.
+     */
+    static
+    bool
+    isSharedDefinition(Decl const* D);
+
     /*  Traverse the members of a declaration
 
         This function is called to traverse the members of
@@ -585,6 +682,15 @@ private:
         std::unique_ptr<Javadoc>& javadoc,
         Decl const* D);
 
+    /*  Convert the comments deferred by generateJavadoc
+
+        The comments of each symbol are converted in
+        order, and the symbols are distributed among
+        the threads of the thread pool.
+     */
+    void
+    buildJavadoc();
+
     std::unique_ptr<TypeInfo>
     toTypeInfo(QualType qt);
 
@@ -714,9 +820,14 @@ private:
     bool
     checkSymbolFilters(std::string_view symbolName, bool const isScope) const;
 
-    template <bool isScope>
     bool
-    checkSymbolFiltersImpl(std::string_view symbolName) const;
+    checkSymbolFilters(SymbolFilterState const& state, bool const isScope) const;
+
+    SymbolFilterState&
+    symbolFilterState(DeclContext const* DC) const;
+
+    SymbolFilterState
+    makeSymbolFilterState(NamedDecl const* ND) const;
 
     SmallString<256>
     qualifiedName(Decl const* D) const;
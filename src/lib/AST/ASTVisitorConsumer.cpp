@@ -14,6 +14,7 @@
 #include "lib/AST/ASTVisitorConsumer.hpp"
 #include "lib/AST/ASTVisitor.hpp"
 #include "lib/Support/Path.hpp"
+#include "lib/Support/Trace.hpp"
 
 namespace clang {
 namespace mrdocs {
@@ -26,11 +27,35 @@ HandleTranslationUnit(ASTContext& Context)
     Diagnostics diags;
     ASTVisitor visitor(
         config_,
+        ex_,
         diags,
         compiler_,
         Context,
         *sema_);
-    visitor.build();
+    {
+        trace::Span span("Visit AST");
+        visitor.build();
+    }
+
+    // report the main file and every included file,
+    // so the results can be invalidated when one changes
+    SourceManager const& source = compiler_.getSourceManager();
+    std::vector<std::string> dependencies;
+    auto const addDependency = [&](FileEntry const* entry)
+    {
+        if(entry)
+        {
+            dependencies.emplace_back(entry->tryGetRealPathName());
+        }
+    };
+    addDependency(source.getFileEntryForID(source.getMainFileID()));
+    for(FileEntry const* file : compiler_.getPreprocessor().getIncludedFiles())
+    {
+        addDependency(file);
+    }
+    ex_.reportDependencies(std::move(dependencies));
+
+    trace::Span span("Report results");
     ex_.report(std::move(visitor.results()), std::move(diags));
 }
 
@@ -115,6 +115,7 @@ class JavadocVisitor
     FullComment const* FC_;
     Javadoc jd_;
     Diagnostics& diags_;
+    std::mutex* sourceMutex_;
     doc::List<doc::Param> params_;
     doc::Block* block_ = nullptr;
     doc::Text* last_child_ = nullptr;
@@ -217,7 +218,8 @@ public:
      */
     JavadocVisitor(
         FullComment const*, Decl const*,
-        Config const&, Diagnostics&);
+        Config const&, Diagnostics&,
+        std::mutex* sourceMutex);
 
     /** Extract the javadoc from the comment.
 
@@ -228,6 +230,15 @@ public:
      */
     Javadoc build();
 
+    /** Return the presumed location of a source location.
+
+        The source manager caches the last queries,
+        so the queries are serialized when comments
+        are parsed concurrently.
+     */
+    PresumedLoc
+    getPresumedLoc(SourceLocation loc) const;
+
     /** Visit any abstract comment.
 
         This is the base case for all comments.
@@ -422,15 +433,29 @@ JavadocVisitor(
     FullComment const* FC,
     Decl const* D,
     Config const& config,
-    Diagnostics& diags)
+    Diagnostics& diags,
+    std::mutex* sourceMutex)
     : config_(config)
     , ctx_(D->getASTContext())
     , sm_(ctx_.getSourceManager())
     , FC_(FC)
     , diags_(diags)
+    , sourceMutex_(sourceMutex)
 {
 }
 
+PresumedLoc
+JavadocVisitor::
+getPresumedLoc(SourceLocation loc) const
+{
+    if (!sourceMutex_)
+    {
+        return sm_.getPresumedLoc(loc);
+    }
+    std::lock_guard<std::mutex> lock(*sourceMutex_);
+    return sm_.getPresumedLoc(loc);
+}
+
 Javadoc
 JavadocVisitor::
 build()
@@ -537,7 +562,7 @@ visitHTMLStartTagComment(
     HTMLStartTagComment const* C)
 {
     MRDOCS_ASSERT(C->child_begin() == C->child_end());
-    PresumedLoc const loc = sm_.getPresumedLoc(C->getBeginLoc());
+    PresumedLoc const loc = getPresumedLoc(C->getBeginLoc());
     auto filename = files::makePosixStyle(loc.getFilename());
 
     auto getAttribute = [&C](StringRef name) -> Expected<std::string>
@@ -1417,7 +1442,7 @@ goodArgCount(std::size_t n,
 {
     if(C.getNumArgs() != n)
     {
-        auto loc = sm_.getPresumedLoc(C.getBeginLoc());
+        auto loc = getPresumedLoc(C.getBeginLoc());
 
         diags_.error(fmt::format(
             "Expected {} but got {} args\n"
@@ -1459,9 +1484,10 @@ parseJavadoc(
     FullComment const* FC,
     Decl const* D,
     Config const& config,
-    Diagnostics& diags)
+    Diagnostics& diags,
+    std::mutex* sourceMutex)
 {
-    auto result = JavadocVisitor(FC, D, config, diags).build();
+    auto result = JavadocVisitor(FC, D, config, diags, sourceMutex).build();
     if(jd == nullptr)
     {
         // Do not create javadocs which have no nodes
@@ -16,6 +16,7 @@
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Config.hpp>
 #include <mrdocs/Metadata/Javadoc.hpp>
+#include <mutex>
 
 namespace clang {
 
@@ -48,6 +49,9 @@ initCustomCommentCommands(
     @param D The declaration to which the comment applies
     @param config The MrDocs configuration object
     @param diags The diagnostics object
+    @param sourceMutex If not null, the mutex which
+    is locked to query the source manager, when
+    comments are parsed concurrently
 */
 void
 parseJavadoc(
@@ -55,7 +59,8 @@ parseJavadoc(
     comments::FullComment const* FC,
     Decl const* D,
     Config const& config,
-    Diagnostics& diags);
+    Diagnostics& diags,
+    std::mutex* sourceMutex = nullptr);
 
 } // mrdocs
 } // clang
@@ -234,12 +234,18 @@ namespace detail
        used to defer the evaluation of a property
        to a later time, which is useful for functionality
        that requires accessing the value.
+
+       The functions return `false` when the
+       remaining properties are not needed, such
+       as when the key was found, and the next
+       calls to `map` and `defer` return at once.
      */
     template <class MapFn, class DeferFn = void*>
     class LazyObjectIO
     {
         MapFn mapFn;
         DeferFn deferFn;
+        bool done = false;
     public:
         explicit
         LazyObjectIO(MapFn mapFn, DeferFn deferFn = {})
@@ -249,20 +255,27 @@ namespace detail
         void
         map(std::string_view name, T const& value)
         {
-            mapFn(name, value);
+            if (!done)
+            {
+                done = !mapFn(name, value);
+            }
         }
 
         template <class F>
         void
         defer(std::string_view name, F&& deferred)
         {
+            if (done)
+            {
+                return;
+            }
             if constexpr (std::same_as<DeferFn, void*>)
             {
-                mapFn(name, deferred);
+                done = !mapFn(name, deferred);
             }
             else
             {
-                deferFn(name, deferred);
+                done = !deferFn(name, deferred);
             }
         }
     };
@@ -279,10 +292,12 @@ LazyObjectImpl<T, Context>::
 size() const
 {
     std::size_t result = 0;
+    bool const hasOverlay = !overlay_.empty();
     detail::LazyObjectIO io(
-        [&result, this](std::string_view name, auto const& /* value or deferred */)
+        [&result, hasOverlay, this](std::string_view name, auto const& /* value or deferred */)
         {
-            result += !overlay_.exists(name);
+            result += !hasOverlay || !overlay_.exists(name);
+            return true;
         });
     if constexpr (HasLazyObjectMapWithContext<T, Context>)
     {
@@ -309,10 +324,8 @@ exists(std::string_view key) const
     detail::LazyObjectIO io(
         [&result, key](std::string_view name, auto const& /* value or deferred */)
     {
-        if (!result && name == key)
-        {
-            result = true;
-        }
+        result = name == key;
+        return !result;
     });
     if constexpr (HasLazyObjectMapWithContext<T, Context>)
     {
@@ -340,30 +353,34 @@ get(std::string_view key) const
     detail::LazyObjectIO io(
         [&result, key, this](std::string_view name, auto const& value)
         {
-            if (result.isUndefined() && name == key)
+            if (name != key)
             {
-                if constexpr (HasValueFromWithContext<std::remove_cvref_t<decltype(value)>, Context>)
-                {
-                    ValueFrom(value, context_, result);
-                }
-                else
-                {
-                    ValueFrom(value, result);
-                }
+                return true;
+            }
+            if constexpr (HasValueFromWithContext<std::remove_cvref_t<decltype(value)>, Context>)
+            {
+                ValueFrom(value, context_, result);
             }
+            else
+            {
+                ValueFrom(value, result);
+            }
+            return false;
         }, [&result, key, this](std::string_view name, auto const& deferred)
         {
-            if (result.isUndefined() && name == key)
+            if (name != key)
             {
-                if constexpr (HasValueFromWithContext<std::remove_cvref_t<decltype(deferred())>, Context>)
-                {
-                    ValueFrom(deferred(), context_, result);
-                }
-                else
-                {
-                    ValueFrom(deferred(), result);
-                }
+                return true;
+            }
+            if constexpr (HasValueFromWithContext<std::remove_cvref_t<decltype(deferred())>, Context>)
+            {
+                ValueFrom(deferred(), context_, result);
+            }
+            else
+            {
+                ValueFrom(deferred(), result);
             }
+            return false;
         });
     if constexpr (HasLazyObjectMapWithContext<T, Context>)
     {
@@ -392,10 +409,11 @@ LazyObjectImpl<T, Context>::
 visit(std::function<bool(String, Value)> fn) const
 {
     bool visitMore = true;
+    bool const hasOverlay = !overlay_.empty();
     detail::LazyObjectIO io(
-        [&visitMore, &fn, this](std::string_view name, auto const& value)
+        [&visitMore, &fn, hasOverlay, this](std::string_view name, auto const& value)
         {
-            if (visitMore && !overlay_.exists(name))
+            if (!hasOverlay || !overlay_.exists(name))
             {
                 if constexpr (HasValueFromWithContext<std::remove_cvref_t<decltype(value)>, Context>)
                 {
@@ -406,9 +424,10 @@ visit(std::function<bool(String, Value)> fn) const
                     visitMore = fn(name, dom::ValueFrom(value));
                 }
             }
-        }, [&visitMore, &fn, this](std::string_view name, auto const& deferred)
+            return visitMore;
+        }, [&visitMore, &fn, hasOverlay, this](std::string_view name, auto const& deferred)
         {
-            if (visitMore && !overlay_.exists(name))
+            if (!hasOverlay || !overlay_.exists(name))
             {
                 if constexpr (HasValueFromWithContext<std::remove_cvref_t<decltype(deferred())>, Context>)
                 {
@@ -419,6 +438,7 @@ visit(std::function<bool(String, Value)> fn) const
                     visitMore = fn(name, dom::ValueFrom(deferred()));
                 }
             }
+            return visitMore;
         });
     if constexpr (HasLazyObjectMapWithContext<T, Context>)
     {
@@ -0,0 +1,105 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Dom/StringPool.hpp"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+namespace dom {
+
+namespace {
+
+constexpr std::size_t shardCount = 16;
+constexpr std::size_t blockSize = 64 * 1024;
+
+} // (anon)
+
+struct alignas(64) StringPool::Shard
+{
+    std::mutex mutex;
+    std::unordered_set<std::string_view> strings;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* pos = nullptr;
+    std::size_t avail = 0;
+
+    // Copy a string and its null terminator
+    // into the memory of the shard
+    char const*
+    store(std::string_view str)
+    {
+        std::size_t const n = str.size() + 1;
+        if (n > avail)
+        {
+            std::size_t const size = std::max(n, blockSize);
+            blocks.push_back(std::make_unique<char[]>(size));
+            pos = blocks.back().get();
+            avail = size;
+        }
+        char* const result = pos;
+        std::memcpy(result, str.data(), str.size());
+        result[str.size()] = '\0';
+        pos += n;
+        avail -= n;
+        return result;
+    }
+};
+
+StringPool::
+StringPool()
+    : shards_(std::make_unique<Shard[]>(shardCount))
+{
+}
+
+StringPool::
+~StringPool() = default;
+
+String
+StringPool::
+intern(std::string_view str)
+{
+    if (str.empty())
+    {
+        return {};
+    }
+    if (str.find('\0') != std::string_view::npos)
+    {
+        return String(str);
+    }
+    Shard& s = shards_[std::hash<std::string_view>()(str) % shardCount];
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto it = s.strings.find(str);
+    if (it == s.strings.end())
+    {
+        it = s.strings.emplace(s.store(str), str.size()).first;
+    }
+    return String(it->data(), String::literal_tag{});
+}
+
+std::size_t
+StringPool::
+size() const
+{
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < shardCount; ++i)
+    {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex);
+        n += shards_[i].strings.size();
+    }
+    return n;
+}
+
+} // dom
+} // mrdocs
+} // clang
@@ -0,0 +1,74 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_DOM_STRINGPOOL_HPP
+#define MRDOCS_LIB_DOM_STRINGPOOL_HPP
+
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Dom/String.hpp>
+#include <memory>
+#include <string_view>
+
+namespace clang {
+namespace mrdocs {
+namespace dom {
+
+/** A pool of interned strings.
+
+    Each distinct string is copied once into
+    the memory of the pool, and the strings
+    returned for it reference that copy as
+    if it were a string literal. Copying and
+    destroying these strings does not allocate
+    or update a reference count.
+
+    The strings returned by the pool must not
+    outlive it. The pool is safe to use from
+    multiple threads.
+*/
+class MRDOCS_DECL
+    StringPool
+{
+    struct Shard;
+
+    std::unique_ptr<Shard[]> shards_;
+
+public:
+    /** Constructor.
+    */
+    StringPool();
+
+    /** Destructor.
+    */
+    ~StringPool();
+
+    StringPool(StringPool const&) = delete;
+    StringPool& operator=(StringPool const&) = delete;
+
+    /** Return the interned string with the same contents.
+
+        Strings which contain null characters
+        cannot be interned, and a ref-counted
+        copy is returned instead.
+    */
+    String
+    intern(std::string_view str);
+
+    /** Return the number of distinct strings in the pool.
+    */
+    std::size_t
+    size() const;
+};
+
+} // dom
+} // mrdocs
+} // clang
+
+#endif
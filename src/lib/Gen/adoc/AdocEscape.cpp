@@ -10,6 +10,7 @@
 //
 
 #include "AdocEscape.hpp"
+#include "lib/Support/CharSet.hpp"
 #include <mrdocs/Support/Handlebars.hpp>
 
 namespace clang::mrdocs::adoc {
@@ -59,26 +60,21 @@ HTMLNamedEntity(char const c)
 void
 AdocEscape(OutputRef& os, std::string_view str)
 {
-    static constexpr char reserved[] = R"(~^_*`#[]{}<>\|-=&;+:."\'/)";
-    for (char c: str)
+    // The null character is part of the set
+    static constexpr CharSet reserved(
+        std::string_view(R"(~^_*`#[]{}<>\|-=&;+:."\'/)", 26));
+    replaceChars(os, str, reserved, [](OutputRef& os, char const c)
     {
-        if (std::ranges::find(reserved, c) != std::end(reserved))
+        // https://docs.asciidoctor.org/asciidoc/latest/subs/replacements/
+        if (auto e = HTMLNamedEntity(c))
         {
-            // https://docs.asciidoctor.org/asciidoc/latest/subs/replacements/
-            if (auto e = HTMLNamedEntity(c))
-            {
-                os << *e;
-            }
-            else
-            {
-                os << "&#" << static_cast<int>(c) << ';';
-            }
+            os << *e;
         }
         else
         {
-            os << c;
+            os << "&#" << static_cast<int>(c) << ';';
         }
-    }
+    });
 }
 
 std::string
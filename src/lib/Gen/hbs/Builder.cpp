@@ -11,6 +11,7 @@
 
 #include "Builder.hpp"
 #include <lib/Lib/ConfigImpl.hpp>
+#include <lib/Support/Trace.hpp>
 #include <mrdocs/Metadata/DomCorpus.hpp>
 #include <mrdocs/Support/Path.hpp>
 #include <llvm/Support/Path.h>
@@ -160,12 +161,9 @@ relativize_fn(dom::Value to0, dom::Value from0, dom::Value options)
 
 
 
-Builder::
-Builder(
-    HandlebarsCorpus const& corpus,
-    std::function<void(OutputRef&, std::string_view)> escapeFn)
-    : escapeFn_(std::move(escapeFn))
-    , domCorpus(corpus)
+BuilderEnvironment::
+BuilderEnvironment(HandlebarsCorpus const& corpus)
+    : domCorpus(corpus)
 {
     namespace fs = std::filesystem;
 
@@ -174,6 +172,12 @@ Builder(
     loadPartials(hbs_, templatesDir("partials"));
 
     // Load JavaScript helpers
+    //
+    // The scripts are compiled by each builder. Until
+    // then, a placeholder is registered in their place,
+    // so we know which helpers are replaced by the
+    // helpers registered later.
+    std::vector<dom::Function> placeholders;
     std::string helpersPath = templatesDir("helpers");
     auto exp = forEachFile(helpersPath, true,
         [&](std::string_view pathName)-> Expected<void>
@@ -184,7 +188,9 @@ Builder(
             auto name = files::getFileName(pathName);
             name.remove_suffix(ext.size());
             MRDOCS_TRY(auto script, files::getFileText(pathName));
-            MRDOCS_TRY(js::registerHelper(hbs_, name, ctx_, script));
+            helperScripts_.emplace_back(name, std::move(script));
+            placeholders.push_back(dom::makeInvocable([] { return dom::Value(); }));
+            hbs_.registerHelper(name, placeholders.back());
             return {};
         });
     if (!exp)
@@ -254,27 +260,81 @@ Builder(
         {
             text.error().Throw();
         }
-        templates_.emplace(filename, text.value());
+        templates_.emplace(filename, Handlebars::compile(*text));
+    }
+
+    // Keep the JavaScript helpers which were not replaced
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < helperScripts_.size(); ++i)
+    {
+        std::string const& name = helperScripts_[i].first;
+        dom::Function const* fn = hbs_.findHelper(name);
+        if (!fn || fn->impl() != placeholders[i].impl())
+        {
+            continue;
+        }
+        hbs_.unregisterHelper(name);
+        if (n != i)
+        {
+            helperScripts_[n] = std::move(helperScripts_[i]);
+        }
+        ++n;
+    }
+    helperScripts_.resize(n);
+}
+
+HandlebarsTemplate const*
+BuilderEnvironment::
+findTemplate(std::string_view name) const
+{
+    auto it = templates_.find(name);
+    if (it == templates_.end())
+    {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+//------------------------------------------------
+
+Builder::
+Builder(
+    BuilderEnvironment const& env,
+    std::function<void(OutputRef&, std::string_view)> escapeFn)
+    : env_(env)
+    , hbs_(env.handlebars())
+    , escapeFn_(std::move(escapeFn))
+    , domCorpus(env.domCorpus)
+{
+    // Compile the JavaScript helpers in the
+    // context of this builder
+    for (auto const& [name, script] : env_.helperScripts())
+    {
+        auto exp = js::registerHelper(hbs_, name, ctx_, script);
+        if (!exp)
+        {
+            exp.error().Throw();
+        }
     }
 }
 
+
 //------------------------------------------------
 
 Expected<void>
 Builder::
 callTemplate(
-    std::ostream& os,
+    OutputRef out,
     std::string_view name,
     dom::Value const& context)
 {
-    auto it = templates_.find(name);
-    MRDOCS_CHECK(it != templates_.end(), formatError("Template {} not found", name));
-    std::string_view fileText = it->second;
+    HandlebarsTemplate const* tmpl = env_.findTemplate(name);
+    MRDOCS_CHECK(tmpl, formatError("Template {} not found", name));
+    trace::Span span("Template", name);
     HandlebarsOptions options;
     options.escapeFunction = escapeFn_;
-    OutputRef out(os);
     Expected<void, HandlebarsError> exp =
-        hbs_.try_render_to(out, fileText, context, options);
+        hbs_.try_render_to(out, *tmpl, context, options);
     if (!exp)
     {
         return Unexpected(Error(exp.error().what()));
@@ -328,6 +388,23 @@ requires std::derived_from<T, Info> || std::same_as<T, OverloadSet>
 Expected<void>
 Builder::
 operator()(std::ostream& os, T const& I)
+{
+    return render(os, I);
+}
+
+template<class T>
+requires std::derived_from<T, Info> || std::same_as<T, OverloadSet>
+Expected<void>
+Builder::
+operator()(std::string& out, T const& I)
+{
+    return render(out, I);
+}
+
+template<class Out, class T>
+Expected<void>
+Builder::
+render(Out& os, T const& I)
 {
     std::string const templateFile = fmt::format("index.{}.hbs", domCorpus.fileExtension);
     dom::Object ctx = createContext(I);
@@ -369,14 +446,14 @@ renderWrapped(
     }));
 
     // Render the wrapper directly to ostream
-    auto pathName = files::appendPath(layoutDir(), wrapperFile);
-    MRDOCS_TRY(auto fileText, files::getFileText(pathName));
+    HandlebarsTemplate const* tmpl = env_.findTemplate(wrapperFile);
+    MRDOCS_CHECK(tmpl, formatError("Template {} not found", wrapperFile));
     HandlebarsOptions options;
     options.escapeFunction = escapeFn_;
     OutputRef outRef(os);
     Expected<void, HandlebarsError> exp =
         hbs_.try_render_to(
-            outRef, fileText, ctx, options);
+            outRef, *tmpl, ctx, options);
     if (!exp)
     {
         Error(exp.error().what()).Throw();
@@ -385,14 +462,14 @@ renderWrapped(
 }
 
 std::string
-Builder::
+BuilderEnvironment::
 layoutDir() const
 {
     return templatesDir("layouts");
 }
 
 std::string
-Builder::
+BuilderEnvironment::
 templatesDir() const
 {
     Config const& config = domCorpus->config;
@@ -403,7 +480,7 @@ templatesDir() const
 }
 
 std::string
-Builder::
+BuilderEnvironment::
 templatesDir(std::string_view subdir) const
 {
     Config const& config = domCorpus->config;
@@ -415,7 +492,7 @@ templatesDir(std::string_view subdir) const
 }
 
 std::string
-Builder::
+BuilderEnvironment::
 commonTemplatesDir() const
 {
     Config const& config = domCorpus->config;
@@ -426,7 +503,7 @@ commonTemplatesDir() const
 }
 
 std::string
-Builder::
+BuilderEnvironment::
 commonTemplatesDir(std::string_view subdir) const
 {
     Config const& config = domCorpus->config;
@@ -438,10 +515,13 @@ commonTemplatesDir(std::string_view subdir) const
 }
 
 // Define Builder::operator() for each Info type
-#define INFO(T) template Expected<void> Builder::operator()<T##Info>(std::ostream&, T##Info const&);
+#define INFO(T) \
+    template Expected<void> Builder::operator()<T##Info>(std::ostream&, T##Info const&); \
+    template Expected<void> Builder::operator()<T##Info>(std::string&, T##Info const&);
 #include <mrdocs/Metadata/InfoNodesPascal.inc>
 
 template Expected<void> Builder::operator()<OverloadSet>(std::ostream&, OverloadSet const&);
+template Expected<void> Builder::operator()<OverloadSet>(std::string&, OverloadSet const&);
 
 } // hbs
 } // mrdocs
@@ -18,12 +18,97 @@
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/Handlebars.hpp>
 #include <mrdocs/Support/JavaScript.hpp>
+#include <map>
 #include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
 namespace hbs {
 
+/** The state shared by the builders of all threads
+
+    The partials, layout templates, and helpers
+    are loaded once. Each @ref Builder copies the
+    handlebars environment, which shares the
+    compiled partials and the helper functions,
+    and refers to the layout templates.
+
+    The scripts of the JavaScript helpers are
+    also read once, but each builder compiles
+    them in its own JavaScript context, because
+    a context can only be used by one thread.
+*/
+class BuilderEnvironment
+{
+    Handlebars hbs_;
+    std::map<std::string, HandlebarsTemplate, std::less<>> templates_;
+    std::vector<std::pair<std::string, std::string>> helperScripts_;
+
+public:
+    HandlebarsCorpus const& domCorpus;
+
+    /** Constructor.
+
+        @throws Exception if the templates or the
+        helpers cannot be loaded.
+    */
+    explicit
+    BuilderEnvironment(HandlebarsCorpus const& corpus);
+
+    /** The handlebars environment with the partials and the C++ helpers.
+     */
+    Handlebars const&
+    handlebars() const noexcept
+    {
+        return hbs_;
+    }
+
+    /** Return a layout template, or `nullptr` if it was not found.
+     */
+    HandlebarsTemplate const*
+    findTemplate(std::string_view name) const;
+
+    /** The names and scripts of the JavaScript helpers.
+
+        These are the helpers which are not replaced
+        by helpers implemented in C++.
+     */
+    std::vector<std::pair<std::string, std::string>> const&
+    helperScripts() const noexcept
+    {
+        return helperScripts_;
+    }
+
+private:
+    /** The directory with the all templates.
+     */
+    std::string
+    templatesDir() const;
+
+    /** A subdirectory of the templates dir
+     */
+    std::string
+    templatesDir(std::string_view subdir) const;
+
+    /** The directory with the common templates.
+     */
+    std::string
+    commonTemplatesDir() const;
+
+    /** A subdirectory of the common templates dir
+     */
+    std::string
+    commonTemplatesDir(std::string_view subdir) const;
+
+    /** The directory with the layout templates.
+     */
+    std::string
+    layoutDir() const;
+};
+
 /** Builds reference output as a string for any Info type
 
     This contains all the state information
@@ -31,9 +116,9 @@ namespace hbs {
 */
 class Builder
 {
+    BuilderEnvironment const& env_;
     js::Context ctx_;
     Handlebars hbs_;
-    std::map<std::string, std::string, std::less<>> templates_;
     std::function<void(OutputRef&, std::string_view)> escapeFn_;
 
     std::string
@@ -44,7 +129,7 @@ public:
 
     explicit
     Builder(
-        HandlebarsCorpus const& corpus,
+        BuilderEnvironment const& env,
         std::function<void(OutputRef&, std::string_view)> escapeFn);
 
     /** Render the contents for a symbol.
@@ -62,6 +147,17 @@ public:
     Expected<void>
     operator()(std::ostream& os, T const&);
 
+    /** Render the contents for a symbol to a string.
+
+        The contents are appended to the string.
+
+        @copydetails operator()(std::ostream&, T const&)
+     */
+    template<class T>
+    requires std::derived_from<T, Info> || std::same_as<T, OverloadSet>
+    Expected<void>
+    operator()(std::string& out, T const&);
+
     /** Render the contents in the wrapper layout.
 
         This function will render the contents
@@ -79,30 +175,9 @@ public:
         std::function<Expected<void>()> contentsCb);
 
 private:
-    /** The directory with the all templates.
-     */
-    std::string
-    templatesDir() const;
-
-    /** A subdirectory of the templates dir
-     */
-    std::string
-    templatesDir(std::string_view subdir) const;
-
-    /** The directory with the common templates.
-     */
-    std::string
-    commonTemplatesDir() const;
-
-    /** A subdirectory of the common templates dir
-     */
-    std::string
-    commonTemplatesDir(std::string_view subdir) const;
-
-    /** The directory with the layout templates.
-     */
-    std::string
-    layoutDir() const;
+    template<class Out, class T>
+    Expected<void>
+    render(Out& out, T const& I);
 
     /** Create a handlebars context with the symbol and helper information.
 
@@ -123,7 +198,7 @@ private:
      */
     Expected<void>
     callTemplate(
-        std::ostream& os,
+        OutputRef out,
         std::string_view name,
         dom::Value const& context);
 
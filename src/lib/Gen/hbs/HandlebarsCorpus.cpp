@@ -267,8 +267,8 @@ construct(Info const& I) const
     dom::Object obj = this->DomCorpus::construct(I);
     if (shouldGenerate(I))
     {
-        obj.set("url", getURL(I));
-        obj.set("anchor", names_.getQualified(I.id, '-'));
+        obj.set("url", intern(getURL(I)));
+        obj.set("anchor", intern(names_.getQualified(I.id, '-')));
         return obj;
     }
 
@@ -277,8 +277,8 @@ construct(Info const& I) const
     // for the primary template if it's part of the corpus.
     if (Info const* primaryInfo = findPrimarySiblingWithUrl(getCorpus(), I))
     {
-        obj.set("url", getURL(*primaryInfo));
-        obj.set("anchor", names_.getQualified(primaryInfo->id, '-'));
+        obj.set("url", intern(getURL(*primaryInfo)));
+        obj.set("anchor", intern(names_.getQualified(primaryInfo->id, '-')));
     }
     return obj;
 }
@@ -289,8 +289,8 @@ construct(
     OverloadSet const& I) const
 {
     auto obj = this->DomCorpus::construct(I);
-    obj.set("url", getURL(I));
-    obj.set("anchor", names_.getQualified(I, '-'));
+    obj.set("url", intern(getURL(I)));
+    obj.set("anchor", intern(names_.getQualified(I, '-')));
     return obj;
 }
 
@@ -26,6 +26,7 @@
 #include <mrdocs/Support/Path.hpp>
 
 #include <fstream>
+#include <memory>
 #include <sstream>
 
 namespace clang {
@@ -40,19 +41,32 @@ createEscapeFn(HandlebarsGenerator const& gen)
     };
 }
 
+Expected<std::unique_ptr<BuilderEnvironment>>
+createEnvironment(HandlebarsCorpus const& hbsCorpus)
+{
+    try
+    {
+        return std::make_unique<BuilderEnvironment>(hbsCorpus);
+    }
+    catch(Exception const& ex)
+    {
+        return Unexpected(ex.error());
+    }
+}
+
 Expected<ExecutorGroup<Builder>>
 createExecutors(
     HandlebarsGenerator const& gen,
-    HandlebarsCorpus const& hbsCorpus)
+    BuilderEnvironment const& env)
 {
-    auto const& config = hbsCorpus->config;
+    auto const& config = env.domCorpus->config;
     auto& threadPool = config.threadPool();
     ExecutorGroup<Builder> group(threadPool);
     for(auto i = threadPool.getThreadCount(); i--;)
     {
         try
         {
-           group.emplace(hbsCorpus, createEscapeFn(gen));
+           group.emplace(env, createEscapeFn(gen));
         }
         catch(Exception const& ex)
         {
@@ -75,6 +89,39 @@ createDomCorpus(
         }};
 }
 
+// The number of pages rendered ahead of the
+// output of a single page for each thread
+constexpr std::size_t singlePageWindow = 8;
+
+Expected<void>
+visitSinglePage(
+    ExecutorGroup<Builder>& ex,
+    Corpus const& corpus,
+    std::ostream& os)
+{
+    SinglePageVisitor visitor(ex, corpus, os,
+        singlePageWindow * corpus.config.threadPool().getThreadCount());
+    visitor(corpus.globalNamespace());
+
+    // Wait for all executors to finish and check errors
+    auto errors = ex.wait();
+    MRDOCS_CHECK_OR(errors.empty(), Unexpected(errors));
+
+    report::debug(
+        "Buffered at most {} bytes of pages",
+        visitor.peakBufferedBytes());
+    return {};
+}
+
+void
+reportCacheStats(HandlebarsCorpus const& domCorpus)
+{
+    auto const stats = domCorpus.cacheStats();
+    report::info(
+        "DOM cache: {} hits, {} misses, {} rebuilds",
+        stats.hits, stats.misses, stats.rebuilds);
+}
+
 //------------------------------------------------
 //
 // HandlebarsGenerator
@@ -108,10 +155,12 @@ build(
 
     // Create corpus and executors
     HandlebarsCorpus domCorpus = createDomCorpus(*this, corpus);
-    MRDOCS_TRY(ExecutorGroup<Builder> ex, createExecutors(*this, domCorpus));
+    MRDOCS_TRY(auto env, createEnvironment(domCorpus));
+    MRDOCS_TRY(ExecutorGroup<Builder> ex, createExecutors(*this, *env));
 
     // Visit the corpus
-    MultiPageVisitor visitor(ex, outputPath, corpus);
+    OutputSink sink(corpus.config->skipUnchanged);
+    MultiPageVisitor visitor(ex, outputPath, corpus, sink);
     visitor(corpus.globalNamespace());
 
     // Wait for all executors to finish and check errors
@@ -119,6 +168,11 @@ build(
     MRDOCS_CHECK_OR(errors.empty(), Unexpected(errors));
 
     report::info("Generated {} pages", visitor.count());
+    reportCacheStats(domCorpus);
+    if (sink.unchanged() != 0)
+    {
+        report::info("{} pages were unchanged", sink.unchanged());
+    }
 
     if (! corpus.config->tagfile.empty())
     {
@@ -140,35 +194,26 @@ buildOne(
 {
     // Create corpus and executors
     HandlebarsCorpus domCorpus = createDomCorpus(*this, corpus);
-    MRDOCS_TRY(ExecutorGroup<Builder> ex, createExecutors(*this, domCorpus));
+    MRDOCS_TRY(auto env, createEnvironment(domCorpus));
+    MRDOCS_TRY(ExecutorGroup<Builder> ex, createExecutors(*this, *env));
 
     // Embedded mode
     if (corpus.config->embedded)
     {
         // Visit the corpus
-        SinglePageVisitor visitor(ex, corpus, os);
-        visitor(corpus.globalNamespace());
-
-        // Wait for all executors to finish and check errors
-        auto errors = ex.wait();
-        MRDOCS_CHECK_OR(errors.empty(), Unexpected(errors));
-
+        MRDOCS_TRY(visitSinglePage(ex, corpus, os));
+        reportCacheStats(domCorpus);
         return {};
     }
 
     // Wrapped mode
-    Builder inlineBuilder(domCorpus, createEscapeFn(*this));
-    return inlineBuilder.renderWrapped(os, [&]() -> Expected<void> {
+    Builder inlineBuilder(*env, createEscapeFn(*this));
+    MRDOCS_TRY(inlineBuilder.renderWrapped(os, [&]() -> Expected<void> {
         // This helper will write contents directly to ostream
-        SinglePageVisitor visitor(ex, corpus, os);
-        visitor(corpus.globalNamespace());
-
-        // Wait for all executors to finish and check errors
-        auto errors = ex.wait();
-        MRDOCS_CHECK_OR(errors.empty(), Unexpected(errors));
-
-        return {};
-    });
+        return visitSinglePage(ex, corpus, os);
+    }));
+    reportCacheStats(domCorpus);
+    return {};
 }
 
 void
@@ -11,7 +11,7 @@
 
 #include "MultiPageVisitor.hpp"
 #include "VisitorHelpers.hpp"
-#include <fstream>
+#include "lib/Support/Trace.hpp"
 #include <mrdocs/Support/Path.hpp>
 
 namespace clang::mrdocs::hbs {
@@ -46,39 +46,26 @@ operator()(T const& I0)
     ex_.async([this, Ref](Builder& builder)
     {
         T const& I = Ref;
+        std::string const path = files::appendPath(
+            outputPath_, builder.domCorpus.getURL(I));
+        trace::Span span("Page", path);
 
         // ===================================
-        // Open the output file
+        // Generate the output
         // ===================================
-        std::string path = files::appendPath(outputPath_, builder.domCorpus.getURL(I));
-        std::string dir = files::getParentDir(path);
-        if (auto exp = files::createDirectory(dir); !exp)
+        // The page is rendered to a buffer owned by the
+        // thread, which keeps its capacity between pages
+        thread_local std::string buffer;
+        buffer.clear();
+        if (auto exp = builder(buffer, I); !exp)
         {
             exp.error().Throw();
         }
-        std::ofstream os;
-        try
-        {
-            os.open(path,
-                    std::ios_base::binary |
-                        std::ios_base::out |
-                        std::ios_base::trunc // | std::ios_base::noreplace
-            );
-            if (!os.is_open()) {
-                formatError(R"(std::ofstream("{}") failed)", path)
-                    .Throw();
-            }
-        }
-        catch (std::exception const& ex)
-        {
-            formatError(R"(std::ofstream("{}") threw "{}")", path, ex.what())
-                .Throw();
-        }
 
         // ===================================
-        // Generate the output
+        // Write the output file
         // ===================================
-        if (auto exp = builder(os, I); !exp)
+        if (auto exp = sink_.write(path, buffer); !exp)
         {
             exp.error().Throw();
         }
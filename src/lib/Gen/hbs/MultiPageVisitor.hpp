@@ -13,6 +13,7 @@
 #define MRDOCS_LIB_GEN_HBS_MULTIPAGEVISITOR_HPP
 
 #include "Builder.hpp"
+#include "lib/Support/OutputSink.hpp"
 #include <mrdocs/Support/ExecutorGroup.hpp>
 #include <mrdocs/Metadata/Info.hpp>
 #include <mutex>
@@ -30,16 +31,19 @@ class MultiPageVisitor
     ExecutorGroup<Builder>& ex_;
     std::string_view outputPath_;
     Corpus const& corpus_;
+    OutputSink& sink_;
     std::atomic<std::size_t> count_ = 0;
 
 public:
     MultiPageVisitor(
         ExecutorGroup<Builder>& ex,
         std::string_view outputPath,
-        Corpus const& corpus) noexcept
+        Corpus const& corpus,
+        OutputSink& sink) noexcept
         : ex_(ex)
         , outputPath_(outputPath)
         , corpus_(corpus)
+        , sink_(sink)
     {
     }
 
@@ -11,8 +11,9 @@
 
 #include "SinglePageVisitor.hpp"
 #include "VisitorHelpers.hpp"
+#include "lib/Support/Trace.hpp"
 #include <mrdocs/Support/unlock_guard.hpp>
-#include <sstream>
+#include <algorithm>
 
 namespace clang::mrdocs::hbs {
 
@@ -40,22 +41,34 @@ operator()(T const& I0)
             return OverloadSet(I0);
         }
     }();
-    ex_.async([this, Ref, symbolIdx = numSymbols_++](Builder& builder)
+    // Wait for the output before rendering more pages,
+    // unless another page failed
+    std::size_t const symbolIdx = numSymbols_++;
+    if (waitForSlot(symbolIdx))
     {
-        T const& I = Ref;
-
-        // Output to an independent string first, then write to
-        // the shared stream
-        std::stringstream ss;
-        if(auto r = builder(ss, I))
-        {
-            writePage(ss.str(), symbolIdx);
-        }
-        else
+        ex_.async([this, Ref, symbolIdx](Builder& builder)
         {
-            r.error().Throw();
-        }
-    });
+            T const& I = Ref;
+
+            // Output to an independent string first, then write to
+            // the shared stream
+            std::string pageText;
+            try
+            {
+                trace::Span span("Page", I.Name);
+                if (auto r = builder(pageText, I); !r)
+                {
+                    r.error().Throw();
+                }
+            }
+            catch (...)
+            {
+                fail();
+                throw;
+            }
+            writePage(std::move(pageText), symbolIdx);
+        });
+    }
 
     if constexpr (std::derived_from<T, Info>)
     {
@@ -75,6 +88,29 @@ operator()(T const& I0)
 }
 
 // pageNumber is zero-based
+bool
+SinglePageVisitor::
+waitForSlot(std::size_t symbolIdx)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_.wait(lock, [&]
+    {
+        return failed_ || symbolIdx < topSymbol_ + window_;
+    });
+    return !failed_;
+}
+
+void
+SinglePageVisitor::
+fail() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed_ = true;
+    }
+    written_.notify_all();
+}
+
 void
 SinglePageVisitor::
 writePage(
@@ -83,12 +119,12 @@ writePage(
 {
     std::unique_lock<std::mutex> lock(mutex_);
 
-    if (symbolIdx > topSymbol_)
+    if (symbolIdx != topSymbol_)
     {
         // Defer this symbol
-        if( symbols_.size() <= symbolIdx)
-            symbols_.resize(symbolIdx + 1);
-        symbols_[symbolIdx] = std::move(pageText);
+        bufferedBytes_ += pageText.size();
+        peakBufferedBytes_ = std::max(peakBufferedBytes_, bufferedBytes_);
+        pending_[symbolIdx % window_] = std::move(pageText);
         return;
     }
 
@@ -101,29 +137,22 @@ writePage(
             os_.write(
                 pageText.data(),
                 static_cast<std::streamsize>(pageText.size()));
-            ++symbolIdx;
-        }
-
-        topSymbol_ = symbolIdx;
-        if(symbolIdx >= symbols_.size())
-        {
-            // No deferred symbols to write
-            return;
         }
 
-        if(! symbols_[symbolIdx])
+        topSymbol_ = ++symbolIdx;
+        auto& next = pending_[symbolIdx % window_];
+        if (!next)
         {
-            // The next symbol is not set yet
-            return;
+            // The next symbol is not rendered yet
+            break;
         }
 
-        // Render the next deferred symbol
-        pageText = std::move(*symbols_[symbolIdx]);
-        // VFALCO this is in theory not needed, but
-        // I am paranoid about the std::move of the
-        // string not resulting in a deallocation.
-        symbols_[symbolIdx].reset();
+        pageText = std::move(*next);
+        next.reset();
+        bufferedBytes_ -= pageText.size();
     }
+    lock.unlock();
+    written_.notify_all();
 }
 
 #define INFO(T) template void SinglePageVisitor::operator()<T##Info>(T##Info const&);
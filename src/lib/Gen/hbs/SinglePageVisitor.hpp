@@ -15,7 +15,9 @@
 #include "Builder.hpp"
 #include <mrdocs/MetadataFwd.hpp>
 #include <mrdocs/Support/ExecutorGroup.hpp>
+#include <condition_variable>
 #include <mutex>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -25,6 +27,17 @@ namespace mrdocs {
 namespace hbs {
 
 /** Visitor which writes everything to a single page.
+
+    The pages of the symbols are rendered concurrently
+    and written in the order they are visited. A page
+    which is rendered before the pages which precede
+    it is buffered until they are written.
+
+    At most `window` pages are rendered ahead of the
+    last page written: the visitor waits for the
+    output before it pushes more tasks, so a slow
+    page does not cause the other pages to
+    accumulate in memory.
 */
 class SinglePageVisitor
 {
@@ -32,19 +45,41 @@ class SinglePageVisitor
     Corpus const& corpus_;
     std::ostream& os_;
     std::size_t numSymbols_ = 0;
+    std::size_t const window_;
+
     std::mutex mutex_;
+    std::condition_variable written_;
     std::size_t topSymbol_ = 0;
-    std::vector<std::optional<std::string>> symbols_;
+    bool failed_ = false;
+    // the pages rendered ahead of topSymbol_,
+    // indexed by the symbol modulo the window
+    std::vector<std::optional<std::string>> pending_;
+    std::size_t bufferedBytes_ = 0;
+    std::size_t peakBufferedBytes_ = 0;
 
+    bool waitForSlot(std::size_t symbolIdx);
     void writePage(std::string pageText, std::size_t symbolIdx);
+    void fail() noexcept;
+
 public:
+    /** Constructor.
+
+        @param ex The executors which render the pages.
+        @param corpus The corpus.
+        @param os The output stream.
+        @param window The maximum number of pages
+        rendered ahead of the output.
+    */
     SinglePageVisitor(
         ExecutorGroup<Builder>& ex,
         Corpus const& corpus,
-        std::ostream& os) noexcept
+        std::ostream& os,
+        std::size_t window)
         : ex_(ex)
         , corpus_(corpus)
         , os_(os)
+        , window_(window ? window : 1)
+        , pending_(window_)
     {
     }
 
@@ -57,6 +92,18 @@ public:
     template <class T>
     requires std::derived_from<T, Info> || std::same_as<T, OverloadSet>
     void operator()(T const& I);
+
+    /** Return the largest number of bytes buffered at once.
+
+        This is the size of the pages which were
+        rendered but waited for the preceding pages
+        to be written.
+    */
+    std::size_t
+    peakBufferedBytes() const noexcept
+    {
+        return peakBufferedBytes_;
+    }
 };
 
 } // hbs
@@ -631,7 +631,7 @@ writeLocation(
     bool def)
 {
     tags_.write("file", {}, {
-        { "path", loc.Filename },
+        { "path", loc.filename() },
         { "line", std::to_string(loc.LineNumber) },
         { "class", "def", def } });
 }
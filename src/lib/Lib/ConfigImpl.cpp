@@ -120,6 +120,10 @@ load(
     MRDOCS_TRY(Config::Settings::load(s, "", dirs));
     s.configYaml = publicSettings.configYaml;
 
+    // Symbol filters
+    s.includeSymbolSet = SymbolGlobPatternSet(s.includeSymbols);
+    s.excludeSymbolSet = SymbolGlobPatternSet(s.excludeSymbols);
+
     // Config strings
     c->configObj_ = toDomObject(s.configYaml);
 
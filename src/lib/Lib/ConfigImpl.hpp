@@ -16,6 +16,7 @@
 #include "lib/Support/YamlFwd.hpp"
 #include <mrdocs/Config.hpp>
 #include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/Glob.hpp>
 #include <llvm/Support/ThreadPool.h>
 #include <memory>
 
@@ -37,7 +38,16 @@ class ConfigImpl
 public:
     struct access_token {};
 
-    struct SettingsImpl : Settings {};
+    struct SettingsImpl : Settings
+    {
+        /** The include-symbols patterns matched together.
+        */
+        SymbolGlobPatternSet includeSymbolSet;
+
+        /** The exclude-symbols patterns matched together.
+        */
+        SymbolGlobPatternSet excludeSymbolSet;
+    };
 
     /// @copydoc Config::settings()
     Settings const&
@@ -10,6 +10,8 @@
 //
 
 #include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Lib/Lookup.hpp"
+#include "lib/Lib/NameTable.hpp"
 #include <mrdocs/Corpus.hpp>
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Support/Error.hpp>
@@ -20,8 +22,27 @@ namespace mrdocs {
 
 //------------------------------------------------
 
+Corpus::
+Corpus(
+    Config const& config_) noexcept
+    : config(config_)
+{
+}
+
 Corpus::~Corpus() noexcept = default;
 
+NameTable const&
+Corpus::
+defaultNames() const
+{
+    std::call_once(defaultNamesOnce_, [&]
+    {
+        defaultNames_ = std::make_unique<NameTable>(
+            *this, config.threadPool());
+    });
+    return *defaultNames_;
+}
+
 //------------------------------------------------
 //
 // Observers
@@ -35,6 +56,47 @@ empty() const noexcept
     return begin() == end();
 }
 
+std::size_t
+Corpus::
+size() const noexcept
+{
+    return static_cast<std::size_t>(end() - begin());
+}
+
+Info const*
+Corpus::
+lookup(
+    SymbolID const& context,
+    std::string_view name) const
+{
+    Info const* I = find(context);
+    if(! I)
+        return nullptr;
+    std::call_once(defaultLookupOnce_, [&]
+    {
+        defaultLookup_ = std::make_unique<SymbolLookup>(*this);
+    });
+    return defaultLookup_->lookup(I, name,
+        [](Info const&)
+        {
+            return true;
+        });
+}
+
+std::span<SymbolID const>
+Corpus::
+parents(Info const& I) const noexcept
+{
+    return defaultNames().parents(I);
+}
+
+std::string_view
+Corpus::
+qualifiedName(Info const& I) const noexcept
+{
+    return defaultNames().qualifiedName(I);
+}
+
 /** Return the metadata for the global namespace.
 */
 NamespaceInfo const&
@@ -50,81 +112,33 @@ globalNamespace() const noexcept
 //
 //------------------------------------------------
 
-// KRYSTIAN NOTE: temporary
 void
 Corpus::
 qualifiedName(
     const Info& I,
     std::string& temp) const
 {
-    temp.clear();
-    if(! I.id || I.id == SymbolID::global)
-    {
-        return;
-    }
+    temp.assign(qualifiedName(I));
+}
 
-    MRDOCS_ASSERT(I.Parent);
-    for(auto const& pID : getParents(*this, I))
-    {
-        if (!pID || pID == SymbolID::global)
-        {
-            continue;
-        }
-        if (Info const* P = find(pID))
-        {
-            if (!P->Name.empty())
-            {
-                temp.append(P->Name);
-            }
-            else
-            {
-                fmt::format_to(
-                    std::back_inserter(temp),
-                    "<unnamed {}>",
-                    toString(P->Kind));
-            }
-        }
-        else
-        {
-            temp.append("<unnamed>");
-        }
-        temp.append("::");
-    }
-    if (I.Name.empty())
-    {
-        fmt::format_to(
-            std::back_inserter(temp),
-            "<unnamed {}>",
-            toString(I.Kind));
-    }
-    else
-    {
-        temp.append(I.Name);
-    }
+std::ranges::subrange<Corpus::iterator>
+partitionIndex(
+    Corpus const& C,
+    std::size_t const i,
+    std::size_t const n) noexcept
+{
+    MRDOCS_ASSERT(i < n);
+    std::size_t const count = C.size();
+    auto const first = static_cast<Corpus::iterator::difference_type>(count * i / n);
+    auto const last = static_cast<Corpus::iterator::difference_type>(count * (i + 1) / n);
+    return { C.begin() + first, C.begin() + last };
 }
 
 std::vector<SymbolID>
 getParents(Corpus const& C, const Info& I)
 {
-    std::vector<SymbolID> parents;
-    std::size_t n = 0;
-    auto curParent = I.Parent;
-    while (curParent)
-    {
-        ++n;
-        MRDOCS_ASSERT(C.find(curParent));
-        curParent = C.get(curParent).Parent;
-    }
-    parents.reserve(n);
-    parents.resize(n);
-    curParent = I.Parent;
-    while (curParent)
-    {
-        parents[--n] = curParent;
-        MRDOCS_ASSERT(C.find(curParent));
-        curParent = C.get(curParent).Parent;
-    }
-    return parents;
+    auto const parents = C.parents(I);
+    return { parents.begin(), parents.end() };
 }
 
 } // mrdocs
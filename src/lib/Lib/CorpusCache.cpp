@@ -0,0 +1,407 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "CorpusCache.hpp"
+#include "lib/Metadata/Serialize.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <mrdocs/Version.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+// Identifies the files in the cache directory
+constexpr std::string_view entryMagic = "mrdocs-tu-cache";
+
+class Digest
+{
+    llvm::SHA1 sha1_;
+
+public:
+    void
+    add(std::string_view s)
+    {
+        // The size keeps consecutive strings
+        // from being ambiguous
+        std::string const size = std::to_string(s.size());
+        sha1_.update(llvm::StringRef(size.data(), size.size() + 1));
+        sha1_.update(llvm::StringRef(s.data(), s.size()));
+    }
+
+    void
+    add(bool b)
+    {
+        add(std::string_view(b ? "1" : "0"));
+    }
+
+    void
+    add(std::vector<std::string> const& v)
+    {
+        add(std::to_string(v.size()));
+        for(auto const& s : v)
+            add(s);
+    }
+
+    template<class GlobPattern>
+        requires requires(GlobPattern const& p) { p.pattern(); }
+    void
+    add(std::vector<GlobPattern> const& v)
+    {
+        add(std::to_string(v.size()));
+        for(auto const& p : v)
+            add(p.pattern());
+    }
+
+    std::string
+    final()
+    {
+        auto const digest = sha1_.final();
+        return llvm::toHex(digest, true);
+    }
+};
+
+} // (anon)
+
+CorpusCache::
+CorpusCache(
+    std::string_view dir,
+    ConfigImpl const& config)
+    : dir_(dir)
+{
+    // Only the options which affect the extracted
+    // symbols are part of the key, so changing the
+    // generator options does not invalidate the cache.
+    // The options which affect the compile commands
+    // are part of the commands.
+    auto const& s = config.settings();
+    Digest d;
+    d.add(project_version);
+    d.add(project_version_build);
+    d.add(std::to_string(binaryFormatVersion));
+    d.add(s.sourceRoot);
+    d.add(s.input);
+    d.add(s.recursive);
+    d.add(s.filePatterns);
+    d.add(s.exclude);
+    d.add(s.excludePatterns);
+    d.add(s.includeSymbols);
+    d.add(s.excludeSymbols);
+    d.add(s.seeBelow);
+    d.add(s.implementationDefined);
+    d.add(s.sfinae);
+    d.add(s.privateMembers);
+    d.add(s.privateBases);
+    d.add(s.anonymousNamespaces);
+    settingsDigest_ = d.final();
+}
+
+std::string
+CorpusCache::
+key(std::vector<tooling::CompileCommand> const& commands) const
+{
+    Digest d;
+    d.add(settingsDigest_);
+    d.add(std::to_string(commands.size()));
+    for(auto const& cmd : commands)
+    {
+        d.add(cmd.Directory);
+        d.add(cmd.Filename);
+        d.add(cmd.CommandLine);
+    }
+    return d.final();
+}
+
+Expected<CorpusCache::Dependency>
+CorpusCache::
+getDependency(std::string path)
+{
+    namespace fs = llvm::sys::fs;
+
+    fs::file_status status;
+    if(auto ec = fs::status(path, status))
+    {
+        return Unexpected(formatError(
+            "fs::status(\"{}\") returned \"{}\"", path, ec));
+    }
+    Dependency dep;
+    dep.Path = std::move(path);
+    dep.ModificationTime = static_cast<std::uint64_t>(
+        status.getLastModificationTime().time_since_epoch().count());
+    dep.Size = status.getSize();
+    return dep;
+}
+
+std::optional<CorpusCache::Entry>
+CorpusCache::
+load(std::string_view key) const
+{
+    std::string const path = files::appendPath(dir_, std::string(key) + ".bin");
+    auto buffer = llvm::MemoryBuffer::getFile(path, false, false);
+    if(! buffer)
+        return std::nullopt;
+
+    Entry entry;
+    try
+    {
+        BinaryReader r((*buffer)->getBuffer());
+        if(r.readString() != entryMagic ||
+            r.readUInt() != binaryFormatVersion)
+        {
+            return std::nullopt;
+        }
+
+        auto n = r.readCount();
+        entry.Dependencies.reserve(n);
+        while(n--)
+        {
+            Dependency dep;
+            dep.Path = r.readString();
+            dep.ModificationTime = r.readUInt();
+            dep.Size = r.readUInt();
+            // check the file before reading the rest
+            auto current = getDependency(dep.Path);
+            if(! current ||
+                current->ModificationTime != dep.ModificationTime ||
+                current->Size != dep.Size)
+            {
+                return std::nullopt;
+            }
+            entry.Dependencies.push_back(std::move(dep));
+        }
+
+        n = r.readCount();
+        entry.Provided.reserve(n);
+        while(n--)
+        {
+            SymbolID const id = r.readSymbolID();
+            auto const mode = r.readUInt();
+            if(mode > static_cast<std::uint64_t>(
+                    ExtractionMode::ImplementationDefined))
+            {
+                formatError("invalid extraction mode {}", mode).Throw();
+            }
+            entry.Provided.emplace_back(id, static_cast<ExtractionMode>(mode));
+        }
+
+        n = r.readCount();
+        entry.Borrowed.reserve(n);
+        while(n--)
+            entry.Borrowed.push_back(r.readSymbolID());
+
+        n = r.readCount();
+        while(n--)
+        {
+            std::string msg(r.readString());
+            if(r.readUInt())
+                entry.Diags.error(std::move(msg));
+            else
+                entry.Diags.warn(std::move(msg));
+        }
+
+        // the results are read by replay
+        auto const data = (*buffer)->getBuffer();
+        auto const size = r.remaining();
+        entry.Results.assign(data.end() - size, data.end());
+    }
+    catch(Exception const& ex)
+    {
+        report::debug("Ignoring cache entry \"{}\": {}", path, ex.error());
+        return std::nullopt;
+    }
+    return entry;
+}
+
+Expected<void>
+CorpusCache::
+store(
+    std::string_view key,
+    Entry const& entry) const
+{
+    namespace fs = llvm::sys::fs;
+
+    std::string data;
+    BinaryWriter w(data);
+    w.writeString(entryMagic);
+    w.writeUInt(binaryFormatVersion);
+    w.writeUInt(entry.Dependencies.size());
+    for(auto const& dep : entry.Dependencies)
+    {
+        w.writeString(dep.Path);
+        w.writeUInt(dep.ModificationTime);
+        w.writeUInt(dep.Size);
+    }
+    w.writeUInt(entry.Provided.size());
+    for(auto const& [id, mode] : entry.Provided)
+    {
+        w.writeSymbolID(id);
+        w.writeUInt(static_cast<std::uint64_t>(mode));
+    }
+    w.writeUInt(entry.Borrowed.size());
+    for(auto const& id : entry.Borrowed)
+        w.writeSymbolID(id);
+    w.writeUInt(entry.Diags.messages().size());
+    for(auto const& [msg, isError] : entry.Diags.messages())
+    {
+        w.writeString(msg);
+        w.writeUInt(isError);
+    }
+    data.append(entry.Results);
+
+    std::string const path = files::appendPath(dir_, std::string(key) + ".bin");
+    int fd;
+    llvm::SmallString<128> tempPath;
+    if(auto ec = fs::createUniqueFile(path + ".%%%%%%.tmp", fd, tempPath))
+    {
+        return Unexpected(formatError(
+            "fs::createUniqueFile(\"{}\") returned \"{}\"", path, ec));
+    }
+    {
+        llvm::raw_fd_ostream os(fd, true);
+        os << data;
+        os.close();
+        if(os.has_error())
+        {
+            auto const ec = os.error();
+            os.clear_error();
+            fs::remove(tempPath);
+            return Unexpected(formatError(
+                "writing \"{}\" returned \"{}\"", tempPath.str().str(), ec));
+        }
+    }
+    if(auto ec = fs::rename(tempPath, path))
+    {
+        fs::remove(tempPath);
+        return Unexpected(formatError(
+            "fs::rename(\"{}\") returned \"{}\"", path, ec));
+    }
+    return {};
+}
+
+Expected<void>
+CorpusCache::
+replay(
+    Entry&& entry,
+    ExecutionContext& ex)
+{
+    std::vector<InfoSet> results;
+    try
+    {
+        BinaryReader r(entry.Results);
+        while(! r.empty())
+            results.push_back(r.readInfoSet());
+    }
+    catch(Exception const& e)
+    {
+        return Unexpected(e.error());
+    }
+
+    for(auto const& [id, mode] : entry.Provided)
+        ex.markExtracted(id, mode);
+    if(results.empty())
+    {
+        ex.report({}, std::move(entry.Diags));
+        return {};
+    }
+    for(auto& info : results)
+    {
+        ex.report(std::move(info), std::move(entry.Diags));
+        entry.Diags = {};
+    }
+    return {};
+}
+
+//------------------------------------------------
+
+std::optional<CorpusCache::Entry>
+CachingExecutionContext::
+entry() &&
+{
+    if(! complete_)
+        return std::nullopt;
+    return std::move(entry_);
+}
+
+void
+CachingExecutionContext::
+report(
+    InfoSet&& info,
+    Diagnostics&& diags)
+{
+    BinaryWriter(entry_.Results).writeInfoSet(info);
+    for(auto const& [msg, isError] : diags.messages())
+    {
+        if(isError)
+            entry_.Diags.error(msg);
+        else
+            entry_.Diags.warn(msg);
+    }
+    inner_.report(std::move(info), std::move(diags));
+}
+
+void
+CachingExecutionContext::
+reportEnd(report::Level level)
+{
+    inner_.reportEnd(level);
+}
+
+mrdocs::Expected<InfoSet>
+CachingExecutionContext::
+results()
+{
+    return inner_.results();
+}
+
+void
+CachingExecutionContext::
+markExtracted(
+    SymbolID const& id,
+    ExtractionMode mode)
+{
+    entry_.Provided.emplace_back(id, mode);
+    inner_.markExtracted(id, mode);
+}
+
+std::optional<ExtractionMode>
+CachingExecutionContext::
+findExtracted(SymbolID const& id)
+{
+    auto mode = inner_.findExtracted(id);
+    if(mode)
+        entry_.Borrowed.push_back(id);
+    return mode;
+}
+
+void
+CachingExecutionContext::
+reportDependencies(
+    std::vector<std::string> files)
+{
+    entry_.Dependencies.reserve(
+        entry_.Dependencies.size() + files.size());
+    for(auto& file : files)
+    {
+        auto dep = CorpusCache::getDependency(std::move(file));
+        if(! dep)
+        {
+            complete_ = false;
+            continue;
+        }
+        entry_.Dependencies.push_back(std::move(*dep));
+    }
+}
+
+} // mrdocs
+} // clang
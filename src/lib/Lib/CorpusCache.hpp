@@ -0,0 +1,227 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_CORPUSCACHE_HPP
+#define MRDOCS_LIB_LIB_CORPUSCACHE_HPP
+
+#include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Lib/Diagnostics.hpp"
+#include "lib/Lib/ExecutionContext.hpp"
+#include <mrdocs/Support/Error.hpp>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** An on-disk cache of the results of translation units.
+
+    Each translation unit has one entry in the cache
+    directory. The entry is named after a digest of
+    the compile commands of the translation unit, the
+    configuration options which affect extraction,
+    and the version of MrDocs.
+
+    The entry records the modification time and size
+    of every file the translation unit included, and
+    it is only used while none of these files changed.
+*/
+class CorpusCache
+{
+    std::string dir_;
+    std::string settingsDigest_;
+
+public:
+    /** A file a translation unit depends on.
+    */
+    struct Dependency
+    {
+        std::string Path;
+        std::uint64_t ModificationTime = 0;
+        std::uint64_t Size = 0;
+    };
+
+    /** The cached results of a translation unit.
+    */
+    struct Entry
+    {
+        /** The files included by the translation unit.
+        */
+        std::vector<Dependency> Dependencies;
+
+        /** The definitions the translation unit extracted.
+        */
+        std::vector<std::pair<SymbolID, ExtractionMode>> Provided;
+
+        /** The definitions the translation unit skipped.
+
+            These definitions were extracted by other
+            translation units, so the entry only
+            contains their declarations.
+        */
+        std::vector<SymbolID> Borrowed;
+
+        /** The diagnostics of the translation unit.
+        */
+        Diagnostics Diags;
+
+        /** The reported results.
+
+            This is a sequence of sets written by
+            @ref BinaryWriter::writeInfoSet, one for
+            each time the results were reported.
+        */
+        std::string Results;
+    };
+
+    /** Constructor.
+
+        @param dir The cache directory, which must exist.
+        @param config The configuration.
+    */
+    CorpusCache(
+        std::string_view dir,
+        ConfigImpl const& config);
+
+    /** Return the key of the entry for a translation unit.
+
+        @param commands The compile commands of the
+        translation unit.
+    */
+    std::string
+    key(std::vector<tooling::CompileCommand> const& commands) const;
+
+    /** Return the current state of a file.
+
+        @param path The absolute path of the file.
+    */
+    static
+    Expected<Dependency>
+    getDependency(std::string path);
+
+    /** Load an entry.
+
+        @return The entry, or `std::nullopt` if there is
+        no entry with the key, the entry was written by
+        another version of MrDocs, or any of the files
+        included by the translation unit changed.
+
+        @param key The key of the entry.
+    */
+    std::optional<Entry>
+    load(std::string_view key) const;
+
+    /** Store an entry.
+
+        The entry is written to a temporary file which
+        then replaces any existing entry, so a process
+        reading the cache concurrently never observes
+        a partially written entry.
+
+        @param key The key of the entry.
+        @param entry The entry to store.
+    */
+    Expected<void>
+    store(
+        std::string_view key,
+        Entry const& entry) const;
+
+    /** Report the results of an entry to an execution context.
+
+        The provided definitions are marked as extracted
+        before the results are reported. Nothing is
+        reported if the results cannot be read.
+
+        @param entry The entry to replay.
+        @param ex The execution context.
+    */
+    static
+    Expected<void>
+    replay(
+        Entry&& entry,
+        ExecutionContext& ex);
+};
+
+//------------------------------------------------
+
+/** An execution context which records an entry of the cache.
+
+    The context records the results of a single
+    translation unit, and forwards every call to
+    the execution context of the corpus.
+*/
+class CachingExecutionContext
+    : public ExecutionContext
+{
+    ExecutionContext& inner_;
+    CorpusCache::Entry entry_;
+    bool complete_ = true;
+
+public:
+    /** Constructor.
+
+        @param config The configuration to use.
+        @param inner The context to forward to.
+    */
+    CachingExecutionContext(
+        ConfigImpl const& config,
+        ExecutionContext& inner)
+        : ExecutionContext(config)
+        , inner_(inner)
+    {
+    }
+
+    /** Return the recorded entry.
+
+        @return The entry, or `std::nullopt` if the
+        state of an included file could not be read.
+    */
+    std::optional<CorpusCache::Entry>
+    entry() &&;
+
+    /// @copydoc ExecutionContext::report
+    void
+    report(
+        InfoSet&& info,
+        Diagnostics&& diags) override;
+
+    /// @copydoc ExecutionContext::reportEnd
+    void
+    reportEnd(report::Level level) override;
+
+    /// @copydoc ExecutionContext::results
+    mrdocs::Expected<InfoSet>
+    results() override;
+
+    /// @copydoc ExecutionContext::markExtracted
+    void
+    markExtracted(
+        SymbolID const& id,
+        ExtractionMode mode) override;
+
+    /// @copydoc ExecutionContext::findExtracted
+    std::optional<ExtractionMode>
+    findExtracted(SymbolID const& id) override;
+
+    /// @copydoc ExecutionContext::reportDependencies
+    void
+    reportDependencies(
+        std::vector<std::string> files) override;
+};
+
+} // mrdocs
+} // clang
+
+#endif
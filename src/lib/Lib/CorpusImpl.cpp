@@ -13,14 +13,29 @@
 
 #include "CorpusImpl.hpp"
 #include "lib/AST/FrontendActionFactory.hpp"
+#include "lib/Lib/CorpusCache.hpp"
 #include "lib/Metadata/Finalize.hpp"
+#include "lib/Metadata/Serialize.hpp"
 #include "lib/Lib/Lookup.hpp"
+#include "lib/Lib/PrecompiledHeaders.hpp"
+#include "lib/Lib/TranslationUnitSchedule.hpp"
 #include "lib/Support/Error.hpp"
 #include "lib/Support/Chrono.hpp"
+#include "lib/Support/Trace.hpp"
 #include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/ArenaAllocated.hpp>
 #include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/Path.hpp>
 #include <mrdocs/Support/ThreadPool.hpp>
+#include <mrdocs/Version.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
 #include <chrono>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 namespace clang {
 namespace mrdocs {
@@ -30,22 +45,7 @@ CorpusImpl::
 begin() const noexcept ->
     iterator
 {
-    if(info_.empty())
-        return end();
-    // KRYSTIAN NOTE: this is far from ideal, but i'm not sure
-    // to what extent implementation detail should be hidden.
-    return iterator(this, info_.begin()->get(),
-        [](const Corpus* corpus, const Info* val) ->
-            const Info*
-        {
-            MRDOCS_ASSERT(val);
-            const CorpusImpl* impl =
-                static_cast<const CorpusImpl*>(corpus);
-            auto it = impl->info_.find(val->id);
-            if(++it == impl->info_.end())
-                return nullptr;
-            return it->get();
-        });
+    return iterator(index_.data());
 }
 
 auto
@@ -53,7 +53,38 @@ CorpusImpl::
 end() const noexcept ->
     iterator
 {
-    return iterator();
+    return iterator(index_.data() + index_.size());
+}
+
+void
+CorpusImpl::
+buildIndex()
+{
+    index_.clear();
+    index_.reserve(info_.size());
+    for (auto const& I : info_)
+    {
+        index_.push_back(I.get());
+    }
+    std::ranges::sort(index_,
+        [](Info const* lhs, Info const* rhs)
+        {
+            return lhs->id < rhs->id;
+        });
+}
+
+void
+CorpusImpl::
+buildNames()
+{
+    trace::Span span("Build name table");
+    using clock_type = std::chrono::steady_clock;
+    auto const start_time = clock_type::now();
+    names_ = std::make_unique<NameTable>(*this, config_->threadPool());
+    report::debug(
+        "Built the names of {} declarations in {}",
+        index_.size(),
+        format_duration(clock_type::now() - start_time));
 }
 
 Info*
@@ -78,8 +109,60 @@ find(
     return nullptr;
 }
 
+std::span<SymbolID const>
+CorpusImpl::
+parents(Info const& I) const noexcept
+{
+    MRDOCS_ASSERT(names_);
+    return names_->parents(I);
+}
+
+std::string_view
+CorpusImpl::
+qualifiedName(Info const& I) const noexcept
+{
+    MRDOCS_ASSERT(names_);
+    return names_->qualifiedName(I);
+}
+
+Info const*
+CorpusImpl::
+lookup(
+    SymbolID const& context,
+    std::string_view name) const
+{
+    Info const* I = find(context);
+    if(! I || ! lookup_)
+        return nullptr;
+    return lookup_->lookup(I, name,
+        [](Info const&)
+        {
+            return true;
+        });
+}
+
 //------------------------------------------------
 
+namespace {
+
+// Return the file where the durations of the
+// translation units are stored between runs.
+// The durations are only stored in the cache
+// directory, so runs which do not opt into
+// persistent state never write next to their
+// input or output.
+std::string
+durationsPath(ConfigImpl const& config)
+{
+    if (config->cacheDir.empty())
+    {
+        return {};
+    }
+    return files::appendPath(config->cacheDir, "durations.json");
+}
+
+} // (anon)
+
 mrdocs::Expected<std::unique_ptr<Corpus>>
 CorpusImpl::
 build(
@@ -110,11 +193,60 @@ build(
         makeFrontendActionFactory(context, *config);
     MRDOCS_ASSERT(action);
 
+    // ------------------------------------------
+    // Cache
+    // ------------------------------------------
+    // When a cache directory is configured, the results
+    // of each translation unit are stored in the cache,
+    // and translation units which did not change are
+    // loaded from the cache instead of being parsed.
+    std::optional<CorpusCache> cache;
+    if (!(*config)->cacheDir.empty())
+    {
+        if (auto exp = files::createDirectory((*config)->cacheDir))
+        {
+            cache.emplace((*config)->cacheDir, *config);
+        }
+        else
+        {
+            report::warn("Not using the cache: {}", exp.error());
+        }
+    }
+
+    // The translation units loaded from the cache
+    // which skipped definitions extracted by other
+    // translation units.
+    struct Replayed
+    {
+        std::string path;
+        std::string key;
+        std::vector<SymbolID> borrowed;
+    };
+    std::mutex replayedMutex;
+    std::vector<Replayed> replayed;
+
+    // ------------------------------------------
+    // Precompiled headers
+    // ------------------------------------------
+    // When enabled, translation units with the same
+    // command and preamble share a precompiled header,
+    // which is created once the list of files is known.
+    auto const pchOps = std::make_shared<PCHContainerOperations>();
+    std::optional<PrecompiledHeaders> pch;
+
+    // ------------------------------------------
+    // Schedule
+    // ------------------------------------------
+    // The translation units are extracted longest
+    // first, using the durations of the previous run.
+    TranslationUnitSchedule schedule(durationsPath(*config));
+
     // ------------------------------------------
     // "Process file" task
     // ------------------------------------------
-    auto const processFile =
-        [&](std::string path)
+    auto const runTool =
+        [&](std::string const& path,
+            tooling::FrontendActionFactory* factory)
         {
             // Each thread gets an independent copy of a VFS to allow different
             // concurrent working directories.
@@ -123,16 +255,109 @@ build(
 
             // KRYSTIAN NOTE: ClangTool applies the SyntaxOnly, StripOutput,
             // and StripDependencyFile argument adjusters
-            tooling::ClangTool Tool(compilations, { path },
-                std::make_shared<PCHContainerOperations>(), FS);
+            tooling::ClangTool Tool(compilations, { path }, pchOps, FS);
+
+            // Load the precompiled header of the file, if any
+            if (pch)
+            {
+                if (auto adjuster = pch->adjuster(path))
+                {
+                    Tool.appendArgumentsAdjuster(std::move(adjuster));
+                }
+            }
 
             // Suppress error messages from the tool
             Tool.setPrintErrorMessage(false);
 
-            if (Tool.run(action.get()))
+            auto const start = clock_type::now();
+            if (Tool.run(factory))
             {
                 formatError("Failed to run action on {}", path).Throw();
             }
+            schedule.record(path, start, clock_type::now());
+        };
+
+    auto const extractAndStore =
+        [&](std::string const& path, std::string const& key)
+        {
+            CachingExecutionContext tuContext(*config, context);
+            std::unique_ptr<tooling::FrontendActionFactory> tuAction =
+                makeFrontendActionFactory(tuContext, *config);
+            runTool(path, tuAction.get());
+            auto entry = std::move(tuContext).entry();
+            if (!entry)
+            {
+                return;
+            }
+            if (auto exp = cache->store(key, *entry); !exp)
+            {
+                report::warn("Failed to store \"{}\" in the cache: {}", path, exp.error());
+            }
+        };
+
+    auto const processFile =
+        [&](std::string path)
+        {
+            trace::Span span("Translation unit", path);
+            // The metadata of the translation unit is
+            // allocated together, and released with
+            // the corpus which keeps it
+            ArenaScope arena;
+            if (!cache)
+            {
+                runTool(path, action.get());
+                return;
+            }
+            std::string key = cache->key(compilations.getCompileCommands(path));
+            if (auto entry = cache->load(key))
+            {
+                trace::Span replaySpan("Replay from cache", path);
+                std::vector<SymbolID> borrowed = std::move(entry->Borrowed);
+                if (CorpusCache::replay(std::move(*entry), context))
+                {
+                    report::debug("Loaded \"{}\" from the cache", path);
+                    if (!borrowed.empty())
+                    {
+                        std::lock_guard lock(replayedMutex);
+                        replayed.push_back({
+                            std::move(path), std::move(key), std::move(borrowed) });
+                    }
+                    return;
+                }
+            }
+            extractAndStore(path, key);
+        };
+
+    auto const processFiles =
+        [&](std::vector<std::string> files,
+            auto const& process) -> std::vector<Error>
+        {
+            std::vector<Error> errors;
+            if (files.size() == 1)
+            {
+                try
+                {
+                    process(std::move(files.front()));
+                }
+                catch (Exception const& ex)
+                {
+                    errors.push_back(ex.error());
+                }
+                return errors;
+            }
+            schedule.order(files);
+            TaskGroup taskGroup(config->threadPool());
+            std::size_t index = 0;
+            for (std::string& file : files)
+            {
+                taskGroup.async(
+                [&, idx = ++index, path = std::move(file)]()
+                {
+                    report::debug("[{}/{}] \"{}\"", idx, files.size(), path);
+                    process(path);
+                });
+            }
+            return taskGroup.wait();
         };
 
     // ------------------------------------------
@@ -145,38 +370,66 @@ build(
     // Get a copy of the filename strings
     std::vector<std::string> files = compilations.getAllFiles();
     MRDOCS_CHECK(files, "Compilations database is empty");
-    std::vector<Error> errors;
+
+    if ((*config)->precompiledHeaders)
+    {
+        pch.emplace(compilations, files, pchOps);
+    }
 
     // Run the action on all files in the database
-    if (files.size() == 1)
+    std::vector<Error> errors = processFiles(std::move(files), processFile);
+
+    // A translation unit loaded from the cache only
+    // contains the declarations of the definitions
+    // it skipped. If no translation unit extracted
+    // one of these definitions in this run, the
+    // translation unit is extracted again.
+    std::vector<std::string> stale;
+    std::unordered_map<std::string, std::string> staleKeys;
+    for (Replayed& r : replayed)
     {
-        try
-        {
-            processFile(std::move(files.front()));
-        }
-        catch (Exception const& ex)
+        bool const complete = std::ranges::all_of(r.borrowed,
+            [&](SymbolID const& id)
+            {
+                return context.findExtracted(id).has_value();
+            });
+        if (!complete)
         {
-            errors.push_back(ex.error());
+            staleKeys.emplace(r.path, r.key);
+            stale.push_back(std::move(r.path));
         }
     }
-    else
+    if (!stale.empty())
     {
-        TaskGroup taskGroup(config->threadPool());
-        std::size_t index = 0;
-        for (std::string& file : files)
-        {
-            taskGroup.async(
-            [&, idx = ++index, path = std::move(file)]()
+        report::debug("Extracting {} translation units again", stale.size());
+        auto staleErrors = processFiles(std::move(stale),
+            [&](std::string const& path)
             {
-                report::debug("[{}/{}] \"{}\"", idx, files.size(), path);
-                processFile(path);
+                ArenaScope arena;
+                extractAndStore(path, staleKeys.at(path));
             });
-        }
-        errors = taskGroup.wait();
+        errors.insert(errors.end(),
+            std::make_move_iterator(staleErrors.begin()),
+            std::make_move_iterator(staleErrors.end()));
     }
+
     // Print diagnostics totals
     context.reportEnd(report::Level::info);
 
+    // Report the translation unit which
+    // determined the end of the extraction
+    if (auto last = schedule.last())
+    {
+        report::info(
+            "The last translation unit to finish was \"{}\", extracted in {}",
+            last->Path,
+            format_duration(last->Duration));
+        if (auto exp = schedule.save(); !exp)
+        {
+            report::warn("Failed to store the durations: {}", exp.error());
+        }
+    }
+
     // ------------------------------------------
     // Report warning and error totals
     // ------------------------------------------
@@ -195,6 +448,7 @@ build(
     if(! results)
         return Unexpected(results.error());
     corpus->info_ = std::move(results.value());
+    corpus->buildIndex();
 
     report::info(
         "Extracted {} declarations in {}",
@@ -204,11 +458,147 @@ build(
     // ------------------------------------------
     // Finalize corpus
     // ------------------------------------------
-    auto lookup = std::make_unique<SymbolLookup>(*corpus);
-    finalize(corpus->info_, *lookup);
+    start_time = clock_type::now();
+    {
+        trace::Span span("Build lookup tables");
+        corpus->lookup_ = std::make_unique<SymbolLookup>(*corpus);
+    }
+    report::debug(
+        "Built the lookup tables in {}",
+        format_duration(clock_type::now() - start_time));
+    {
+        trace::Span span("Finalize");
+        MRDOCS_TRY(finalize(corpus->info_, *corpus->lookup_, config->threadPool()));
+    }
+    report::info(
+        "Finalized {} declarations in {}",
+        corpus->info_.size(),
+        format_duration(clock_type::now() - start_time));
+    corpus->buildNames();
+
+    return corpus;
+}
+
+namespace {
+
+// Identifies the files written by CorpusImpl::save
+constexpr std::string_view corpusMagic = "mrdocs-corpus";
+
+} // (anon)
+
+mrdocs::Expected<std::unique_ptr<Corpus>>
+CorpusImpl::
+load(
+    std::shared_ptr<ConfigImpl const> const& config,
+    std::string_view path)
+{
+    using clock_type = std::chrono::steady_clock;
+    auto start_time = clock_type::now();
+
+    report::info("Loading declarations");
+
+    // Large files are memory mapped
+    auto buffer = llvm::MemoryBuffer::getFile(path, false, false);
+    if (!buffer)
+    {
+        return Unexpected(formatError(
+            "llvm::MemoryBuffer::getFile(\"{}\") returned \"{}\"",
+            path, buffer.getError()));
+    }
+
+    std::unique_ptr<CorpusImpl> corpus = std::make_unique<CorpusImpl>(config);
+    try
+    {
+        trace::Span span("Read corpus", path);
+        ArenaScope arena;
+        BinaryReader r((*buffer)->getBuffer());
+        MRDOCS_CHECK(
+            r.readString() == corpusMagic,
+            formatError("\"{}\" is not a corpus file", path));
+        MRDOCS_CHECK(
+            r.readUInt() == binaryFormatVersion &&
+            r.readString() == project_version &&
+            r.readString() == project_version_build,
+            formatError("\"{}\" was saved by another version of MrDocs", path));
+        corpus->info_ = r.readInfoSet();
+        corpus->buildIndex();
+        MRDOCS_CHECK(
+            r.empty(),
+            formatError("\"{}\" has trailing data", path));
+    }
+    catch (Exception const& ex)
+    {
+        return Unexpected(ex.error());
+    }
+
+    {
+        trace::Span span("Build lookup tables");
+        corpus->lookup_ = std::make_unique<SymbolLookup>(*corpus);
+    }
+    corpus->buildNames();
+
+    report::info(
+        "Loaded {} declarations in {}",
+        corpus->info_.size(),
+        format_duration(clock_type::now() - start_time));
 
     return corpus;
 }
 
+mrdocs::Expected<void>
+CorpusImpl::
+save(
+    Corpus const& corpus,
+    std::string_view path)
+{
+    std::string data;
+    BinaryWriter w(data);
+    w.writeString(corpusMagic);
+    w.writeUInt(binaryFormatVersion);
+    w.writeString(project_version);
+    w.writeString(project_version_build);
+    w.writeUInt(corpus.size());
+    for (Info const& I : corpus)
+    {
+        w.writeInfo(I);
+    }
+
+    // The corpus is written to a temporary file which
+    // replaces the file once complete, so an interrupted
+    // run does not leave a truncated corpus behind
+    namespace fs = llvm::sys::fs;
+    MRDOCS_TRY(files::createDirectory(files::getParentDir(path)));
+    int fd;
+    llvm::SmallString<128> tempPath;
+    if (auto ec = fs::createUniqueFile(
+            std::string(path) + ".%%%%%%.tmp", fd, tempPath))
+    {
+        return Unexpected(formatError(
+            "fs::createUniqueFile(\"{}\") returned \"{}\"", path, ec));
+    }
+    {
+        llvm::raw_fd_ostream os(fd, true);
+        os << data;
+        os.close();
+        if (os.has_error())
+        {
+            auto const ec = os.error();
+            os.clear_error();
+            fs::remove(tempPath);
+            return Unexpected(formatError(
+                "writing \"{}\" returned \"{}\"", tempPath.str().str(), ec));
+        }
+    }
+    if (auto ec = fs::rename(tempPath, path))
+    {
+        fs::remove(tempPath);
+        return Unexpected(formatError(
+            "fs::rename(\"{}\") returned \"{}\"", path, ec));
+    }
+
+    report::info("Saved the corpus to \"{}\"", path);
+    return {};
+}
+
 } // mrdocs
 } // clang
@@ -13,14 +13,19 @@
 
 #include "lib/Lib/ConfigImpl.hpp"
 #include "lib/Lib/Info.hpp"
+#include "lib/Lib/Lookup.hpp"
+#include "lib/Lib/NameTable.hpp"
 #include "lib/Support/Debug.hpp"
 #include <mrdocs/Corpus.hpp>
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/Support/Error.hpp>
 #include <clang/Tooling/CompilationDatabase.h>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
@@ -67,6 +72,22 @@ public:
     find(
         SymbolID const& id) noexcept;
 
+    /// @copydoc Corpus::parents
+    std::span<SymbolID const>
+    parents(Info const& I) const noexcept override;
+
+    /// @copydoc Corpus::qualifiedName(Info const&) const
+    std::string_view
+    qualifiedName(Info const& I) const noexcept override;
+
+    using Corpus::qualifiedName;
+
+    /// @copydoc Corpus::lookup
+    Info const*
+    lookup(
+        SymbolID const& context,
+        std::string_view name) const override;
+
     /** Build metadata for a set of translation units.
 
         This is the main point of interaction between MrDocs
@@ -90,11 +111,53 @@ public:
         std::shared_ptr<ConfigImpl const> const& config,
         tooling::CompilationDatabase const& compilations);
 
+    /** Load a corpus saved by @ref save.
+
+        The file is memory mapped, and the symbols
+        are read directly into the index. The symbols
+        were finalized when the corpus was saved, so
+        they are not finalized again.
+
+        @param config A shared pointer to the configuration.
+        @param path The path of the file.
+    */
+    [[nodiscard]]
+    static
+    mrdocs::Expected<std::unique_ptr<Corpus>>
+    load(
+        std::shared_ptr<ConfigImpl const> const& config,
+        std::string_view path);
+
+    /** Save the symbols of a corpus to a file.
+
+        The file uses the binary encoding of the
+        metadata, and it can only be loaded by the
+        same version of MrDocs.
+
+        @param corpus The corpus to save.
+        @param path The path of the file.
+    */
+    static
+    mrdocs::Expected<void>
+    save(
+        Corpus const& corpus,
+        std::string_view path);
+
 private:
     Info const*
     find(
         SymbolID const& id) const noexcept override;
 
+    /** Build the index of all symbols from the set.
+    */
+    void
+    buildIndex();
+
+    /** Build the names of all symbols.
+    */
+    void
+    buildNames();
+
     /** Return the Info with the specified symbol ID.
 
         If the id does not exist, the behavior is undefined.
@@ -111,6 +174,15 @@ private:
 
     // Info keyed on Symbol ID.
     InfoSet info_;
+
+    // The Info in info_ sorted by Symbol ID
+    std::vector<Info const*> index_;
+
+    // Name lookup in info_
+    std::unique_ptr<SymbolLookup> lookup_;
+
+    // Parents and qualified names of the Info in index_
+    std::unique_ptr<NameTable> names_;
 };
 
 template<class T>
@@ -63,6 +63,17 @@ public:
         messages_.emplace(std::move(s), false);
     }
 
+    /** Return the accumulated messages.
+
+        The value of each element is `true`
+        if the message is an error.
+    */
+    std::unordered_map<std::string, bool> const&
+    messages() const noexcept
+    {
+        return messages_;
+    }
+
     /** Print the accumulated diagnostics.
 
         This function prints the accumulated diagnostics
@@ -106,6 +117,29 @@ public:
         report::print(level, s);
     }
 
+    /** Merge diagnostics from another object.
+
+        This function merges the diagnostics from
+        another object into this one, without
+        printing the messages.
+
+        @param other The other diagnostics to merge.
+    */
+    void
+    merge(Diagnostics&& other)
+    {
+        for(auto&& m : other.messages_)
+        {
+            auto [it, ok] = messages_.emplace(std::move(m));
+            if (ok && it->second)
+            {
+                ++errorCount_;
+            }
+        }
+        other.messages_.clear();
+        other.errorCount_ = 0;
+    }
+
     /** Merge diagnostics from another object and print new messages.
 
         This function merges the diagnostics from
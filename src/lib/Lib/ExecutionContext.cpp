@@ -13,7 +13,9 @@
 
 #include "ExecutionContext.hpp"
 #include "lib/Metadata/Reduce.hpp"
+#include "lib/Support/Trace.hpp"
 #include <mrdocs/Metadata.hpp>
+#include <array>
 #include <ranges>
 
 namespace clang {
@@ -78,27 +80,72 @@ report(
     Diagnostics&& diags)
 {
     InfoSet info = std::move(results);
-    // KRYSTIAN TODO: read stage will be required to
-    // update Info references once we switch to using Info*
-    #if 0
+
+    // Partition the new Info by shard. Extracting
+    // the nodes only relinks them, so no Info is
+    // moved or reallocated here.
+    std::array<InfoSet, shardCount> parts;
+    while (!info.empty())
     {
-        std::shared_lock<std::shared_mutex> read_lock(mutex_);
+        auto node = info.extract(info.begin());
+        parts[shardIndex(node.value()->id)].insert(std::move(node));
     }
-    #endif
 
-    std::unique_lock<std::shared_mutex> write_lock(mutex_);
-    // Add all new Info to the existing set.
-    info_.merge(info);
+    // Merge a partition into its shard.
+    // The shard lock must be held.
+    auto const mergeShard = [](InfoSet& dest, InfoSet& part)
+    {
+        // Add all new Info to the existing set.
+        dest.merge(part);
 
-    // Merge duplicate IDs in info_.
-    for (auto& other : info)
+        // Merge duplicate IDs in the shard.
+        for (auto& other : part)
+        {
+            auto it = dest.find(other->id);
+            MRDOCS_ASSERT(it != dest.end());
+            merge(**it, std::move(*other));
+        }
+        part.clear();
+    };
+
+    // First pass: merge into every shard whose lock
+    // is free, skipping the ones other threads are
+    // currently merging into.
+    std::size_t pending = 0;
+    for (std::size_t i = 0; i < shardCount; ++i)
     {
-        auto it = info_.find(other->id);
-        MRDOCS_ASSERT(it != info_.end());
-        merge(**it, std::move(*other));
+        if (parts[i].empty())
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(
+            shards_[i].mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            ++pending;
+            continue;
+        }
+        mergeShard(shards_[i].info, parts[i]);
+    }
+
+    // Second pass: wait for the shards that were busy.
+    for (std::size_t i = 0; pending != 0 && i < shardCount; ++i)
+    {
+        if (parts[i].empty())
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(shards_[i].mutex, std::defer_lock);
+        {
+            trace::Span span("Wait for merge");
+            lock.lock();
+        }
+        mergeShard(shards_[i].info, parts[i]);
+        --pending;
     }
 
     // Merge diagnostics and report any new messages.
+    std::lock_guard<std::mutex> lock(diagsMutex_);
     diags_.mergeAndReport(std::move(diags));
 }
 
@@ -113,7 +160,47 @@ mrdocs::Expected<InfoSet>
 InfoExecutionContext::
 results()
 {
-    return std::move(info_);
+    // The shards are disjoint, so the final
+    // reduction only relinks the nodes of
+    // each shard into a single set.
+    std::size_t n = 0;
+    for (auto& shard : shards_)
+    {
+        n += shard.info.size();
+    }
+    InfoSet info;
+    info.reserve(n);
+    for (auto& shard : shards_)
+    {
+        info.merge(shard.info);
+        MRDOCS_ASSERT(shard.info.empty());
+    }
+    return info;
+}
+
+void
+InfoExecutionContext::
+markExtracted(
+    SymbolID const& id,
+    ExtractionMode mode)
+{
+    Shard& shard = shards_[shardIndex(id)];
+    std::unique_lock<std::shared_mutex> lock(shard.extractedMutex);
+    shard.extracted.try_emplace(id, mode);
+}
+
+std::optional<ExtractionMode>
+InfoExecutionContext::
+findExtracted(SymbolID const& id)
+{
+    Shard& shard = shards_[shardIndex(id)];
+    std::shared_lock<std::shared_mutex> lock(shard.extractedMutex);
+    auto it = shard.extracted.find(id);
+    if (it == shard.extracted.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
 }
 
 } // mrdocs
@@ -18,8 +18,11 @@
 #include "Info.hpp"
 #include <mrdocs/Support/Error.hpp>
 #include <llvm/ADT/SmallString.h>
+#include <array>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -104,6 +107,53 @@ public:
     virtual
     mrdocs::Expected<InfoSet>
     results() = 0;
+
+    /** Record that a definition has been completely extracted.
+
+        This function is called by a translation unit
+        after it has extracted a definition and all
+        of its members. Other translation units which
+        see the same definition can then skip it,
+        since their results would be merged away.
+
+        @param id The symbol ID of the definition.
+        @param mode The extraction mode of the definition.
+    */
+    virtual
+    void
+    markExtracted(
+        SymbolID const& id,
+        ExtractionMode mode) = 0;
+
+    /** Return the extraction mode of a completely extracted definition.
+
+        @return The extraction mode the definition
+        was recorded with by @ref markExtracted, or
+        `std::nullopt` if no translation unit has
+        completely extracted the definition yet.
+
+        @param id The symbol ID of the definition.
+    */
+    virtual
+    std::optional<ExtractionMode>
+    findExtracted(SymbolID const& id) = 0;
+
+    /** Record the files a translation unit depends on.
+
+        This function is called once for each translation
+        unit, before its results are reported, with the
+        main file and every file it includes.
+
+        The default implementation does nothing.
+
+        @param files The absolute paths of the files.
+    */
+    virtual
+    void
+    reportDependencies(
+        std::vector<std::string> files)
+    {
+    }
 };
 
 // ----------------------------------------------------------------
@@ -113,13 +163,62 @@ public:
     It stores the `InfoSet` and `Diagnostics`
     objects, and returns them when `results`
     is called.
+
+    The stored `InfoSet` is partitioned into
+    shards keyed on the first byte of the
+    `SymbolID`. Each shard has its own lock,
+    so translation units reported concurrently
+    only contend when they touch the same shard
+    at the same time.
  */
 class InfoExecutionContext
     : public ExecutionContext
 {
-    std::shared_mutex mutex_;
+    /** A partition of the results.
+
+        All the Info in a shard have a `SymbolID`
+        whose shard index is the index of the shard.
+
+        The registry of extracted definitions is
+        guarded by its own lock, so lookups from
+        translation units being visited do not wait
+        on the merge of other translation units.
+    */
+    struct Shard
+    {
+        std::mutex mutex;
+        InfoSet info;
+
+        std::shared_mutex extractedMutex;
+        std::unordered_map<SymbolID, ExtractionMode> extracted;
+    };
+
+    /** The number of shards.
+
+        This must be a power of two not greater
+        than 256, since the index is taken from
+        a single byte of the `SymbolID`.
+    */
+    static constexpr std::size_t shardCount = 64;
+
+    static_assert((shardCount & (shardCount - 1)) == 0);
+    static_assert(shardCount <= 256);
+
+    /** Return the index of the shard for a symbol.
+
+        The `SymbolID` is a SHA1 digest, so any
+        of its bytes is uniformly distributed.
+    */
+    static
+    std::size_t
+    shardIndex(SymbolID const& id) noexcept
+    {
+        return id.data()[0] & (shardCount - 1);
+    }
+
+    std::mutex diagsMutex_;
     Diagnostics diags_;
-    InfoSet info_;
+    std::array<Shard, shardCount> shards_;
 
 public:
     using ExecutionContext::ExecutionContext;
@@ -146,6 +245,16 @@ public:
     */
     mrdocs::Expected<InfoSet>
     results() override;
+
+    /// @copydoc ExecutionContext::markExtracted
+    void
+    markExtracted(
+        SymbolID const& id,
+        ExtractionMode mode) override;
+
+    /// @copydoc ExecutionContext::findExtracted
+    std::optional<ExtractionMode>
+    findExtracted(SymbolID const& id) override;
 };
 
 } // mrdocs
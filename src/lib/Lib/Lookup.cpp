@@ -9,7 +9,11 @@
 //
 
 #include "Lookup.hpp"
+#include "lib/Support/NameParser.hpp"
 #include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <algorithm>
+#include <functional>
 
 namespace clang {
 namespace mrdocs {
@@ -39,11 +43,13 @@ bool isTransparent(const Info* info)
     });
 }
 
+template<class Entry>
 void
 buildLookups(
     const Corpus& corpus,
+    const Info& context,
     const Info& info,
-    LookupTable& lookups)
+    std::vector<Entry>& entries)
 {
     visit(info, [&]<typename InfoTy>(const InfoTy& I)
     {
@@ -58,46 +64,84 @@ buildLookups(
                 // if the member is an inline namespace or
                 // an unscoped enumeration, add its members as well
                 if(isTransparent(child))
-                    buildLookups(corpus, *child, lookups);
+                    buildLookups(corpus, context, *child, entries);
 
                 // KRYSTIAN TODO: handle inline/anonymous namespaces
                 // KRYSTIAN TODO: injected class names?
                 if(child->Name.empty())
                     continue;
-                lookups.add(child->Name, child);
+                entries.push_back({
+                    &context,
+                    std::hash<std::string_view>()(child->Name),
+                    child->Name,
+                    child});
             }
         }
     });
 }
 
-} // (anon)
-
-LookupTable::
-LookupTable(
-    const Info& info,
-    const Corpus& corpus)
-{
-    MRDOCS_ASSERT(supportsLookup(&info));
+constexpr auto entryLess =
+    []<class Entry>(const Entry& a, const Entry& b) noexcept
+    {
+        if(a.context != b.context)
+            return std::less<const Info*>()(a.context, b.context);
+        return a.hash < b.hash;
+    };
 
-    buildLookups(corpus, info, *this);
-}
+} // (anon)
 
 SymbolLookup::
 SymbolLookup(const Corpus& corpus)
     : corpus_(corpus)
 {
+    std::vector<const Info*> contexts;
     for(const Info& I : corpus_)
     {
-        if(! supportsLookup(&I))
-            continue;
-        lookup_tables_.emplace(&I, LookupTable(I, corpus_));
+        if(supportsLookup(&I))
+            contexts.push_back(&I);
+    }
+
+    // The contexts are sorted like the entries, and
+    // each chunk of contexts is collected and sorted
+    // by a separate task, so the entries are sorted
+    // once the chunks are concatenated.
+    std::ranges::sort(contexts, std::less<const Info*>());
+    ThreadPool& threadPool = corpus_.config.threadPool();
+    std::size_t const n = std::min<std::size_t>(
+        contexts.size(), threadPool.getThreadCount() * 8);
+    std::vector<std::vector<Entry>> chunks(n);
+    TaskGroup taskGroup(threadPool);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        taskGroup.async(
+            [&, i]
+            {
+                std::size_t const first = contexts.size() * i / n;
+                std::size_t const last = contexts.size() * (i + 1) / n;
+                auto& entries = chunks[i];
+                for(std::size_t j = first; j < last; ++j)
+                    buildLookups(corpus_, *contexts[j], *contexts[j], entries);
+                std::stable_sort(entries.begin(), entries.end(), entryLess);
+            });
+    }
+    if(auto errors = taskGroup.wait(); ! errors.empty())
+        Error(errors).Throw();
+
+    std::size_t size = 0;
+    for(auto const& entries : chunks)
+        size += entries.size();
+    entries_.reserve(size);
+    for(auto& entries : chunks)
+    {
+        entries_.insert(entries_.end(), entries.begin(), entries.end());
+        entries = {};
     }
 }
 
 const Info*
 SymbolLookup::
 adjustLookupContext(
-    Info const* context)
+    Info const* context) const
 {
     // find the innermost enclosing context that supports name lookup
     while(! supportsLookup(context))
@@ -110,7 +154,7 @@ adjustLookupContext(
 
 const Info*
 SymbolLookup::
-lookThroughTypedefs(const Info* I)
+lookThroughTypedefs(const Info* I) const
 {
     if(! I || ! I->isTypedef())
         return I;
@@ -125,17 +169,23 @@ lookupInContext(
     const Info* context,
     std::string_view name,
     bool for_nns,
-    LookupCallback& callback)
+    LookupCallback& callback) const
 {
     // if the lookup context is a typedef, we want to
     // lookup the name in the type it denotes
     if(! (context = lookThroughTypedefs(context)))
         return nullptr;
     MRDOCS_ASSERT(supportsLookup(context));
-    LookupTable& table = lookup_tables_.at(context);
+    Entry const key{
+        context, std::hash<std::string_view>()(name), {}, nullptr};
+    auto [first, last] = std::equal_range(
+        entries_.begin(), entries_.end(), key, entryLess);
     // KRYSTIAN FIXME: disambiguation based on signature
-    for(auto& result : table.lookup(name))
+    for(; first != last; ++first)
     {
+        if(first->name != name)
+            continue;
+        const Info* result = first->info;
         if(for_nns)
         {
             // per [basic.lookup.qual.general] p1, when looking up a
@@ -184,7 +234,7 @@ lookupUnqualifiedImpl(
     const Info* context,
     std::string_view name,
     bool for_nns,
-    LookupCallback& callback)
+    LookupCallback& callback) const
 {
     if (!context)
     {
@@ -212,7 +262,7 @@ lookupQualifiedImpl(
     const Info* context,
     std::span<const std::string_view> qualifier,
     std::string_view terminal,
-    LookupCallback& callback)
+    LookupCallback& callback) const
 {
     if(! context)
         return nullptr;
@@ -235,5 +285,37 @@ lookupQualifiedImpl(
         context, terminal, false, callback);
 }
 
+const Info*
+SymbolLookup::
+lookupImpl(
+    const Info* context,
+    std::string_view name,
+    LookupCallback& callback) const
+{
+    auto parse_result = parseIdExpression(name);
+    if(! parse_result || parse_result->name.empty())
+        return nullptr;
+
+    if(! parse_result->qualified)
+    {
+        return lookupUnqualifiedImpl(
+            context, parse_result->name, false, callback);
+    }
+
+    // KRYSTIAN FIXME: lookupQualified should accept
+    // std::vector<std::string> as the qualifier
+    std::vector<std::string_view> qualifier;
+    for(auto& part : parse_result->qualifier)
+        qualifier.push_back(part);
+    if(qualifier.empty())
+    {
+        context = corpus_.find(SymbolID::global);
+        MRDOCS_ASSERT(context);
+    }
+    return lookupQualifiedImpl(
+        context, qualifier, parse_result->name, callback);
+}
+
 } // mrdocs
 } // clang
+
@@ -19,46 +19,39 @@
 #include <string>
 #include <string_view>
 #include <ranges>
-#include <unordered_map>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
 
-class LookupTable
-{
-    // maps unquaified names to symbols with that name.
-    // names from member symbols which are "transparent"
-    // (e.g. unscoped enums and inline namespaces) will
-    // have their members added to the table as well
-    std::unordered_multimap<
-        std::string_view, const Info*> lookups_;
-
-public:
-    LookupTable(
-        const Info& info,
-        const Corpus& corpus);
-
-    auto lookup(std::string_view name) const
-    {
-        auto [first, last] = lookups_.equal_range(name);
-        return std::ranges::subrange(
-            first, last) | std::views::values;
-    }
-
-    void add(std::string_view name, const Info* info)
-    {
-        lookups_.emplace(name, info);
-    }
-};
+/** Name lookup in a corpus.
 
+    The names of the members of every context which
+    supports lookup are stored in a single sorted
+    array, which is built in parallel by the
+    constructor and never modified after. Lookups
+    may be performed concurrently from any number
+    of threads.
+*/
 class SymbolLookup
 {
+    // a name declared in a lookup context. names from
+    // member symbols which are "transparent" (e.g. unscoped
+    // enums and inline namespaces) will have their members
+    // added to the context as well
+    struct Entry
+    {
+        const Info* context;
+        std::size_t hash;
+        std::string_view name;
+        const Info* info;
+    };
+
     const Corpus& corpus_;
 
-    // maps symbol ID to its lookup table, if lookup is supported
-    std::unordered_map<
-        const Info*,
-        LookupTable> lookup_tables_;
+    // sorted by context and hash of the name. entries
+    // with the same key are in declaration order
+    std::vector<Entry> entries_;
 
     struct LookupCallback
     {
@@ -67,48 +60,85 @@ class SymbolLookup
     };
 
     template<typename Fn>
-    auto makeHandler(Fn& fn);
+    static auto makeHandler(Fn& fn);
 
     const Info*
-    adjustLookupContext(const Info* context);
+    adjustLookupContext(const Info* context) const;
 
     const Info*
-    lookThroughTypedefs(const Info* I);
+    lookThroughTypedefs(const Info* I) const;
 
     const Info*
     getTypeAsTag(
-        const std::unique_ptr<TypeInfo>& T);
+        const std::unique_ptr<TypeInfo>& T) const;
 
     const Info*
     lookupInContext(
         const Info* context,
         std::string_view name,
         bool for_nns,
-        LookupCallback& callback);
+        LookupCallback& callback) const;
 
     const Info*
     lookupUnqualifiedImpl(
         const Info* context,
         std::string_view name,
         bool for_nns,
-        LookupCallback& callback);
+        LookupCallback& callback) const;
 
     const Info*
     lookupQualifiedImpl(
         const Info* context,
         std::span<const std::string_view> qualifier,
         std::string_view terminal,
-        LookupCallback& callback);
+        LookupCallback& callback) const;
+
+    const Info*
+    lookupImpl(
+        const Info* context,
+        std::string_view name,
+        LookupCallback& callback) const;
 
 public:
+    /** Constructor.
+
+        The lookup tables are built using the
+        thread pool of the configuration.
+    */
     SymbolLookup(const Corpus& corpus);
 
+    /** Lookup an id-expression.
+
+        A qualified name is looked up in the context
+        named by its nested-name-specifier, and
+        an unqualified name is looked up in the
+        enclosing contexts of `context`.
+
+        @return The first acceptable symbol, or
+        `nullptr` if none was found.
+
+        @param context The context of the name.
+        @param name The id-expression to lookup.
+        @param callback A function which returns `true`
+        if a symbol found by lookup is acceptable.
+    */
+    template<typename Fn>
+    const Info*
+    lookup(
+        const Info* context,
+        std::string_view name,
+        Fn&& callback) const
+    {
+        auto handler = makeHandler(callback);
+        return lookupImpl(context, name, handler);
+    }
+
     template<typename Fn>
     const Info*
     lookupUnqualified(
         const Info* context,
         std::string_view name,
-        Fn&& callback)
+        Fn&& callback) const
     {
         auto handler = makeHandler(callback);
         return lookupUnqualifiedImpl(
@@ -121,7 +151,7 @@ public:
         const Info* context,
         std::span<const std::string_view> qualifier,
         std::string_view terminal,
-        Fn&& callback)
+        Fn&& callback) const
     {
         auto handler = makeHandler(callback);
         return lookupQualifiedImpl(
@@ -0,0 +1,236 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "NameTable.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <fmt/format.h>
+#include <algorithm>
+#include <iterator>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+// Return the number of characters of the
+// component of a qualified name for a symbol
+std::size_t
+componentSize(Info const& I)
+{
+    if (!I.Name.empty())
+    {
+        return I.Name.size();
+    }
+    return fmt::formatted_size("<unnamed {}>", toString(I.Kind));
+}
+
+// Append the component of a qualified name for a symbol
+char*
+appendComponent(char* out, Info const& I)
+{
+    if (!I.Name.empty())
+    {
+        return std::ranges::copy(I.Name, out).out;
+    }
+    return fmt::format_to(out, "<unnamed {}>", toString(I.Kind));
+}
+
+// The component of a parent which is not in the corpus
+constexpr std::string_view missingComponent = "<unnamed>";
+
+// Return true if a parent is part of the qualified name
+bool
+isNamedParent(SymbolID const& id)
+{
+    return id && id != SymbolID::global;
+}
+
+// Call a function with each range of the
+// index of the corpus in parallel
+template <class F>
+void
+forEachRange(
+    Corpus const& corpus,
+    ThreadPool& threadPool,
+    F const& f)
+{
+    std::size_t const n = std::min<std::size_t>(
+        corpus.size(), threadPool.getThreadCount() * 8);
+    TaskGroup taskGroup(threadPool);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        taskGroup.async(
+            [&corpus, &f, i, n]
+            {
+                auto const range = partitionIndex(corpus, i, n);
+                for (auto it = range.begin(); it != range.end(); ++it)
+                {
+                    f(static_cast<std::size_t>(it - corpus.begin()), *it);
+                }
+            });
+    }
+    if (auto errors = taskGroup.wait(); !errors.empty())
+    {
+        Error(errors).Throw();
+    }
+}
+
+} // (anon)
+
+NameTable::
+NameTable(
+    Corpus const& corpus,
+    ThreadPool& threadPool)
+    : corpus_(corpus)
+    , entries_(corpus.size())
+{
+    positions_.reserve(corpus.size());
+    for (auto it = corpus_.begin(); it != corpus_.end(); ++it)
+    {
+        positions_.emplace(
+            &*it, static_cast<std::size_t>(it - corpus_.begin()));
+    }
+
+    // Count the parents and the characters
+    // of the qualified name of each symbol
+    forEachRange(corpus_, threadPool,
+        [this](std::size_t const pos, Info const& I)
+        {
+            Entry& e = entries_[pos];
+            if (!isNamedParent(I.id))
+            {
+                return;
+            }
+            e.nameSize = componentSize(I);
+            for (SymbolID id = I.Parent; id;)
+            {
+                ++e.depth;
+                Info const* P = corpus_.find(id);
+                if (!P)
+                {
+                    // The chain of parents ends
+                    // at a parent which is missing
+                    e.nameSize += missingComponent.size() + 2;
+                    break;
+                }
+                if (isNamedParent(id))
+                {
+                    e.nameSize += componentSize(*P) + 2;
+                }
+                id = P->Parent;
+            }
+        });
+
+    std::size_t depth = 0;
+    std::size_t size = 0;
+    for (Entry& e : entries_)
+    {
+        e.parents = depth;
+        e.name = size;
+        depth += e.depth;
+        size += e.nameSize;
+    }
+    parents_.resize(depth);
+    names_.resize(size);
+
+    // Write the parents and the qualified name
+    // of each symbol, from the innermost parent
+    forEachRange(corpus_, threadPool,
+        [this](std::size_t const pos, Info const& I)
+        {
+            Entry const& e = entries_[pos];
+            if (e.nameSize == 0)
+            {
+                return;
+            }
+            std::size_t n = e.depth;
+            char* const first = names_.data() + e.name;
+            char* last = first + e.nameSize;
+            std::size_t const size = componentSize(I);
+            appendComponent(last - size, I);
+            last -= size;
+            for (SymbolID id = I.Parent; id;)
+            {
+                parents_[e.parents + --n] = id;
+                Info const* P = corpus_.find(id);
+                if (!P)
+                {
+                    last -= 2;
+                    last[0] = ':';
+                    last[1] = ':';
+                    last -= missingComponent.size();
+                    std::ranges::copy(missingComponent, last);
+                    break;
+                }
+                if (isNamedParent(id))
+                {
+                    last -= 2;
+                    last[0] = ':';
+                    last[1] = ':';
+                    std::size_t const parentSize = componentSize(*P);
+                    appendComponent(last - parentSize, *P);
+                    last -= parentSize;
+                }
+                id = P->Parent;
+            }
+            MRDOCS_ASSERT(last == first);
+        });
+}
+
+auto
+NameTable::
+entry(Info const& I) const noexcept ->
+    Entry const*
+{
+    auto it = positions_.find(&I);
+    if (it == positions_.end())
+    {
+        // A copy of a symbol of the corpus
+        Info const* J = corpus_.find(I.id);
+        if (!J || J == &I)
+        {
+            return nullptr;
+        }
+        it = positions_.find(J);
+        if (it == positions_.end())
+        {
+            return nullptr;
+        }
+    }
+    return &entries_[it->second];
+}
+
+std::span<SymbolID const>
+NameTable::
+parents(Info const& I) const noexcept
+{
+    Entry const* e = entry(I);
+    if (!e)
+    {
+        return {};
+    }
+    return { parents_.data() + e->parents, e->depth };
+}
+
+std::string_view
+NameTable::
+qualifiedName(Info const& I) const noexcept
+{
+    Entry const* e = entry(I);
+    if (!e)
+    {
+        return {};
+    }
+    return { names_.data() + e->name, e->nameSize };
+}
+
+} // mrdocs
+} // clang
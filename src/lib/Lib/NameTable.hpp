@@ -0,0 +1,95 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_NAMETABLE_HPP
+#define MRDOCS_LIB_LIB_NAMETABLE_HPP
+
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Corpus.hpp>
+#include <mrdocs/Metadata/Symbols.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** The parents and qualified names of the symbols in a corpus.
+
+    The table is built in parallel once the corpus
+    is finalized. The parents of every symbol are
+    stored in a single array, and the qualified
+    names in a single string, so the functions
+    return views which are valid for the lifetime
+    of the table.
+
+    The entries are in the order of the index of
+    the corpus, and the position of each symbol
+    in the index is stored in a hash table, so
+    the entry of a symbol is found in constant
+    time.
+
+    A parent which is not in the corpus ends the
+    chain of parents of a symbol, and its component
+    of the qualified name is "<unnamed>".
+*/
+class NameTable
+{
+    struct Entry
+    {
+        std::size_t parents = 0;
+        std::size_t depth = 0;
+        std::size_t name = 0;
+        std::size_t nameSize = 0;
+    };
+
+    Corpus const& corpus_;
+    std::unordered_map<Info const*, std::size_t> positions_;
+    std::vector<Entry> entries_;
+    std::vector<SymbolID> parents_;
+    std::string names_;
+
+    Entry const*
+    entry(Info const& I) const noexcept;
+
+public:
+    /** Constructor.
+
+        @param corpus The finalized corpus.
+        @param threadPool The thread pool used
+        to build the table.
+    */
+    NameTable(
+        Corpus const& corpus,
+        ThreadPool& threadPool);
+
+    /** Return the parents of a symbol.
+
+        The parents are ordered from the
+        outermost scope, which is the global
+        namespace, to the parent of the symbol.
+    */
+    std::span<SymbolID const>
+    parents(Info const& I) const noexcept;
+
+    /** Return the fully qualified name of a symbol.
+    */
+    std::string_view
+    qualifiedName(Info const& I) const noexcept;
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -0,0 +1,470 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "PrecompiledHeaders.hpp"
+#include "lib/Support/Chrono.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/FileManager.h>
+#include <clang/Basic/LangOptions.h>
+#include <clang/Driver/Driver.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Lex/Lexer.h>
+#include <clang/Lex/Token.h>
+#include <clang/Tooling/Tooling.h>
+#include <fmt/format.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+#include <chrono>
+#include <ranges>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+bool
+isClangCL(std::vector<std::string> const& commandLine)
+{
+    auto cStrsView = std::views::transform(commandLine, &std::string::c_str);
+    std::vector<char const*> const cStrs(cStrsView.begin(), cStrsView.end());
+    return driver::IsClangCL(
+        driver::getDriverMode(commandLine.front(), cStrs));
+}
+
+// Return true if the argument names the file
+bool
+isInputFile(
+    std::string_view arg,
+    tooling::CompileCommand const& cmd)
+{
+    llvm::SmallString<128> path(arg);
+    llvm::sys::fs::make_absolute(cmd.Directory, path);
+    llvm::sys::path::remove_dots(path, true);
+    llvm::sys::path::native(path);
+    return path.str() == cmd.Filename;
+}
+
+// An #include directive at the beginning of a file
+struct Include
+{
+    // The directive, with its whitespace collapsed
+    std::string Text;
+
+    // Whether the name of the header is quoted
+    bool Quoted = false;
+
+    // The offset of the line after the directive
+    std::size_t End = 0;
+};
+
+// Return the #include directives at the beginning
+// of a file, before any other directive or declaration
+std::vector<Include>
+leadingIncludes(llvm::StringRef text)
+{
+    // As in Lexer::ComputePreamble, the lexer starts
+    // at a fake location so it tracks the offsets
+    constexpr SourceLocation::UIntTy startOffset = 1;
+    LangOptions langOpts;
+    langOpts.CPlusPlus = true;
+    Lexer lexer(
+        SourceLocation::getFromRawEncoding(startOffset),
+        langOpts, text.begin(), text.begin(), text.end());
+    auto const offset = [](Token const& tok)
+    {
+        return tok.getLocation().getRawEncoding() - startOffset;
+    };
+
+    std::vector<Include> result;
+    Token tok;
+    lexer.LexFromRawLexer(tok);
+    while (tok.is(tok::hash) && tok.isAtStartOfLine())
+    {
+        lexer.LexFromRawLexer(tok);
+        if (tok.isAtStartOfLine() ||
+            !tok.is(tok::raw_identifier) ||
+            tok.getRawIdentifier() != "include")
+        {
+            break;
+        }
+        lexer.LexFromRawLexer(tok);
+        if (tok.isAtStartOfLine() || tok.is(tok::eof))
+        {
+            break;
+        }
+        Include inc;
+        inc.Quoted = tok.is(tok::string_literal);
+        std::size_t const start = offset(tok);
+        std::size_t last = offset(tok) + tok.getLength();
+        lexer.LexFromRawLexer(tok);
+        while (!tok.is(tok::eof) && !tok.isAtStartOfLine())
+        {
+            last = offset(tok) + tok.getLength();
+            lexer.LexFromRawLexer(tok);
+        }
+
+        // The directive ends at the line of the next token,
+        // so the comments after it are skipped with it,
+        // unless a block comment ends on that line.
+        inc.End = tok.is(tok::eof)
+            ? text.size()
+            : text.rfind('\n', offset(tok)) + 1;
+        if (inc.End < last ||
+            text.slice(last, inc.End).contains("/*"))
+        {
+            break;
+        }
+
+        inc.Text = "#include ";
+        for (char const c : text.slice(start, last))
+        {
+            if (!llvm::isSpace(c))
+            {
+                inc.Text.push_back(c);
+            }
+            else if (inc.Text.back() != ' ')
+            {
+                inc.Text.push_back(' ');
+            }
+        }
+        result.push_back(std::move(inc));
+    }
+    return result;
+}
+
+// A sequence of #include directives shared by files
+struct Node
+{
+    std::unordered_map<std::string, std::size_t> Children;
+    std::size_t Parent = 0;
+    std::size_t Depth = 0;
+
+    // The number of files starting with the directives
+    std::size_t Count = 0;
+
+    // The number of files sharing these directives
+    // with no longer sequence shared with others
+    std::size_t Users = 0;
+};
+
+// The root of the tree of the files with the same command
+struct Command
+{
+    std::string Directory;
+    std::vector<std::string> CommandLine;
+    std::size_t Root = 0;
+};
+
+// A file which can share its leading #include directives
+struct Candidate
+{
+    std::string File;
+    std::string SourceDirectory;
+    std::vector<Include> Includes;
+    Command const* Cmd = nullptr;
+
+    // The nodes of the directives, from the first one
+    std::vector<std::size_t> Path;
+};
+
+} // (anon)
+
+PrecompiledHeaders::
+PrecompiledHeaders(
+    tooling::CompilationDatabase const& compilations,
+    std::vector<std::string> const& files,
+    std::shared_ptr<PCHContainerOperations> pchOps)
+    : pchOps_(std::move(pchOps))
+{
+    // The files with the same directory and the same
+    // command, apart from the file, are placed in
+    // a tree of their leading #include directives
+    std::vector<Node> nodes;
+    std::unordered_map<std::string, std::unique_ptr<Command>> commands;
+    std::vector<Candidate> candidates;
+    for (std::string const& file : files)
+    {
+        std::vector<tooling::CompileCommand> compileCommands =
+            compilations.getCompileCommands(file);
+        if (compileCommands.size() != 1 ||
+            compileCommands.front().CommandLine.empty() ||
+            isClangCL(compileCommands.front().CommandLine))
+        {
+            continue;
+        }
+        tooling::CompileCommand const& cmd = compileCommands.front();
+
+        auto buffer = llvm::MemoryBuffer::getFile(file);
+        if (!buffer)
+        {
+            continue;
+        }
+        Candidate candidate;
+        candidate.Includes = leadingIncludes((*buffer)->getBuffer());
+        if (candidate.Includes.empty())
+        {
+            continue;
+        }
+        candidate.File = file;
+        candidate.SourceDirectory =
+            llvm::sys::path::parent_path(cmd.Filename).str();
+
+        std::vector<std::string> commandLine;
+        for (std::string const& arg : cmd.CommandLine)
+        {
+            if (arg == "-fsyntax-only" || isInputFile(arg, cmd))
+            {
+                continue;
+            }
+            commandLine.push_back(arg);
+        }
+        commandLine = tooling::getClangStripDependencyFileAdjuster()(
+            tooling::getClangStripOutputAdjuster()(commandLine, file),
+            file);
+        std::string key = cmd.Directory;
+        key.push_back('\0');
+        for (std::string const& arg : commandLine)
+        {
+            key.append(arg).push_back('\0');
+        }
+        auto& command = commands[key];
+        if (!command)
+        {
+            command = std::make_unique<Command>();
+            command->Directory = cmd.Directory;
+            command->CommandLine = std::move(commandLine);
+            command->Root = nodes.size();
+            nodes.emplace_back();
+        }
+        candidate.Cmd = command.get();
+
+        // Quoted includes are relative to the directory
+        // of the file, which is part of their key
+        std::size_t node = command->Root;
+        for (Include const& inc : candidate.Includes)
+        {
+            std::string childKey = inc.Text;
+            if (inc.Quoted)
+            {
+                childKey.append(1, '\0').append(candidate.SourceDirectory);
+            }
+            auto [it, inserted] = nodes[node].Children.try_emplace(
+                std::move(childKey), nodes.size());
+            std::size_t const child = it->second;
+            if (inserted)
+            {
+                Node n;
+                n.Parent = node;
+                n.Depth = nodes[node].Depth + 1;
+                nodes.push_back(std::move(n));
+            }
+            ++nodes[child].Count;
+            candidate.Path.push_back(child);
+            node = child;
+        }
+        candidates.push_back(std::move(candidate));
+    }
+
+    // Each file uses the longest sequence
+    // it shares with another file
+    std::vector<std::size_t> chosen(candidates.size(), 0);
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        Candidate const& c = candidates[i];
+        for (std::size_t j = c.Path.size(); j-- > 0;)
+        {
+            if (nodes[c.Path[j]].Count >= 2)
+            {
+                chosen[i] = c.Path[j];
+                ++nodes[chosen[i]].Users;
+                break;
+            }
+        }
+    }
+
+    // A file which is the only one using its sequence,
+    // because the other files share longer sequences,
+    // uses the longest shorter sequence used by others
+    std::unordered_map<std::size_t, std::vector<std::size_t>> filesOf;
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        std::size_t node = chosen[i];
+        if (node == 0)
+        {
+            continue;
+        }
+        std::size_t const root = candidates[i].Cmd->Root;
+        if (nodes[node].Users < 2)
+        {
+            node = nodes[node].Parent;
+            while (node != root && nodes[node].Users == 0)
+            {
+                node = nodes[node].Parent;
+            }
+        }
+        if (node != root)
+        {
+            filesOf[node].push_back(i);
+        }
+    }
+
+    // A group is only useful if the precompiled
+    // header is loaded by another translation unit
+    for (auto& [node, members] : filesOf)
+    {
+        if (members.size() < 2)
+        {
+            continue;
+        }
+        Candidate const& first = candidates[members.front()];
+        std::size_t const depth = nodes[node].Depth;
+        auto group = std::make_unique<Group>();
+        group->Directory = first.Cmd->Directory;
+        group->SourceDirectory = first.SourceDirectory;
+        group->CommandLine = first.Cmd->CommandLine;
+        for (std::size_t j = 0; j < depth; ++j)
+        {
+            group->Preamble.append(first.Includes[j].Text).push_back('\n');
+        }
+        group->Index = groups_.size();
+        for (std::size_t i : members)
+        {
+            Candidate& c = candidates[i];
+            groupOf_.try_emplace(
+                std::move(c.File),
+                Member{ group.get(), c.Includes[depth - 1].End });
+        }
+        groups_.push_back(std::move(group));
+    }
+    if (groups_.empty())
+    {
+        return;
+    }
+
+    llvm::SmallString<128> dir;
+    if (auto ec = llvm::sys::fs::createUniqueDirectory("mrdocs-pch", dir))
+    {
+        report::warn("Not using precompiled headers: {}", ec.message());
+        groups_.clear();
+        groupOf_.clear();
+        return;
+    }
+    dir_ = dir.str().str();
+    report::debug(
+        "{} translation units share {} precompiled headers",
+        groupOf_.size(), groups_.size());
+}
+
+PrecompiledHeaders::
+~PrecompiledHeaders()
+{
+    if (!dir_.empty())
+    {
+        llvm::sys::fs::remove_directories(dir_);
+    }
+}
+
+void
+PrecompiledHeaders::
+build(Group& group) const
+{
+    using clock_type = std::chrono::steady_clock;
+    auto const start_time = clock_type::now();
+
+    std::string const header = files::appendPath(
+        dir_, fmt::format("preamble-{}.hpp", group.Index));
+    std::string const pch = header + ".pch";
+    {
+        std::error_code ec;
+        llvm::raw_fd_ostream os(header, ec);
+        if (ec)
+        {
+            report::debug("Failed to write \"{}\": {}", header, ec.message());
+            return;
+        }
+        os << group.Preamble;
+    }
+
+    // Quoted includes in the preamble are relative to
+    // the directory of the files in the group, which
+    // is searched first when compiling the header.
+    // The comments of system headers are kept, as
+    // they are when the translation units are parsed.
+    std::vector<std::string> commandLine = group.CommandLine;
+    commandLine.insert(
+        commandLine.begin() + 1,
+        {
+            "-iquote", group.SourceDirectory,
+            "-fretain-comments-from-system-headers"
+        });
+    commandLine.insert(
+        commandLine.end(),
+        { "-x", "c++-header", header, "-o", pch });
+
+    IntrusiveRefCntPtr<llvm::vfs::FileSystem> FS =
+        llvm::vfs::createPhysicalFileSystem();
+    FS->setCurrentWorkingDirectory(group.Directory);
+    IntrusiveRefCntPtr<FileManager> Files(
+        new FileManager(FileSystemOptions(), FS));
+    IgnoringDiagConsumer diags;
+    tooling::ToolInvocation invocation(
+        std::move(commandLine),
+        std::make_unique<GeneratePCHAction>(),
+        Files.get(),
+        pchOps_);
+    invocation.setDiagnosticConsumer(&diags);
+    if (!invocation.run() ||
+        !llvm::sys::fs::exists(pch))
+    {
+        report::debug("Failed to build the precompiled header \"{}\"", pch);
+        return;
+    }
+    group.PCH = pch;
+    report::debug(
+        "Built the precompiled header \"{}\" in {}",
+        pch, format_duration(clock_type::now() - start_time));
+}
+
+tooling::ArgumentsAdjuster
+PrecompiledHeaders::
+adjuster(std::string const& path)
+{
+    auto const it = groupOf_.find(path);
+    if (it == groupOf_.end())
+    {
+        return {};
+    }
+    Group& group = *it->second.group;
+    std::call_once(group.Once, [&]{ build(group); });
+    if (group.PCH.empty())
+    {
+        return {};
+    }
+    // The shared directives of the file are skipped,
+    // since the header contains the same directives.
+    // The comments of system headers are retained
+    // as when the header was precompiled.
+    return tooling::getInsertArgumentAdjuster(
+        {
+            "-include-pch", group.PCH,
+            "-fretain-comments-from-system-headers",
+            "-Xclang", fmt::format(
+                "-preamble-bytes={},1", it->second.skip)
+        },
+        tooling::ArgumentInsertPosition::BEGIN);
+}
+
+} // mrdocs
+} // clang
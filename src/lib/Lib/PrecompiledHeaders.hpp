@@ -0,0 +1,124 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_PRECOMPILEDHEADERS_HPP
+#define MRDOCS_LIB_LIB_PRECOMPILEDHEADERS_HPP
+
+#include <mrdocs/Support/Error.hpp>
+#include <clang/Serialization/PCHContainerOperations.h>
+#include <clang/Tooling/ArgumentsAdjusters.h>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** Precompiled headers shared by translation units.
+
+    The `#include` directives at the beginning of
+    each file, before any other directive or
+    declaration, are placed in a tree shared by
+    the files with the same compile command, apart
+    from the name of the file. Each file is placed
+    in the group of the longest sequence of leading
+    `#include` directives it shares with other files.
+
+    The shared directives of a group are written to
+    a header which is precompiled the first time a
+    translation unit of the group is extracted. The
+    other translation units of the group load the
+    precompiled header and skip the shared
+    directives, so the headers they include are
+    only parsed once.
+
+    Quoted includes are only shared by files in
+    the same directory, since they are relative
+    to the directory of the file.
+
+    The precompiled headers are stored in a temporary
+    directory which is removed by the destructor.
+*/
+class PrecompiledHeaders
+{
+    struct Group
+    {
+        std::string Directory;
+        std::string SourceDirectory;
+        std::vector<std::string> CommandLine;
+        std::string Preamble;
+        std::size_t Index = 0;
+
+        std::once_flag Once;
+        std::string PCH;
+    };
+
+    struct Member
+    {
+        Group* group = nullptr;
+
+        // The number of bytes at the beginning of
+        // the file with the shared directives
+        std::size_t skip = 0;
+    };
+
+    std::string dir_;
+    std::shared_ptr<PCHContainerOperations> pchOps_;
+    std::vector<std::unique_ptr<Group>> groups_;
+    std::unordered_map<std::string, Member> groupOf_;
+
+    void build(Group& group) const;
+
+public:
+    /** Constructor.
+
+        @param compilations The compilation database.
+        @param files The files which will be extracted.
+        @param pchOps The container operations used
+        to write and read the precompiled headers.
+    */
+    PrecompiledHeaders(
+        tooling::CompilationDatabase const& compilations,
+        std::vector<std::string> const& files,
+        std::shared_ptr<PCHContainerOperations> pchOps);
+
+    /** Destructor.
+
+        The precompiled headers are removed.
+    */
+    ~PrecompiledHeaders();
+
+    PrecompiledHeaders(PrecompiledHeaders const&) = delete;
+    PrecompiledHeaders& operator=(PrecompiledHeaders const&) = delete;
+
+    /** Return the adjuster which uses the precompiled header of a file.
+
+        The precompiled header is built if this is the
+        first translation unit of its group. Other threads
+        requesting the same precompiled header wait until
+        it is built.
+
+        @return The adjuster, or an empty function if
+        the file is not part of a group or its
+        precompiled header could not be built.
+
+        @param path The file to extract.
+    */
+    tooling::ArgumentsAdjuster
+    adjuster(std::string const& path);
+};
+
+} // mrdocs
+} // clang
+
+#endif
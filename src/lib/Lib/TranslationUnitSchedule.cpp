@@ -0,0 +1,215 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/TranslationUnitSchedule.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <algorithm>
+#include <map>
+
+namespace clang {
+namespace mrdocs {
+
+TranslationUnitSchedule::
+TranslationUnitSchedule(std::string path)
+    : path_(std::move(path))
+{
+    if (path_.empty() || !files::exists(path_))
+    {
+        return;
+    }
+    auto buffer = llvm::MemoryBuffer::getFile(path_);
+    if (!buffer)
+    {
+        report::debug("Ignoring the durations in \"{}\": {}", path_, buffer.getError());
+        return;
+    }
+    auto json = llvm::json::parse((*buffer)->getBuffer());
+    if (!json)
+    {
+        report::debug("Ignoring the durations in \"{}\": {}", path_, toString(json.takeError()));
+        return;
+    }
+    llvm::json::Object const* obj = json->getAsObject();
+    llvm::json::Object const* durations = obj ? obj->getObject("durations") : nullptr;
+    if (!durations)
+    {
+        return;
+    }
+    for (auto const& [file, value] : *durations)
+    {
+        if (auto us = value.getAsInteger(); us && *us >= 0)
+        {
+            previous_.emplace(file.str(), *us);
+        }
+    }
+}
+
+void
+TranslationUnitSchedule::
+order(std::vector<std::string>& files) const
+{
+    // The size of a file is converted to a duration
+    // with the rate of the files whose duration is known,
+    // so known and estimated costs can be compared.
+    std::vector<std::uint64_t> sizes(files.size(), 0);
+    double knownDuration = 0;
+    double knownSize = 0;
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        std::uint64_t size = 0;
+        if (!llvm::sys::fs::file_size(files[i], size))
+        {
+            sizes[i] = size;
+        }
+        if (auto it = previous_.find(files[i]); it != previous_.end())
+        {
+            knownDuration += static_cast<double>(it->second);
+            knownSize += static_cast<double>(sizes[i]);
+        }
+    }
+    double const rate =
+        knownDuration > 0 && knownSize > 0 ? knownDuration / knownSize : 1;
+
+    std::vector<std::pair<double, std::size_t>> costs;
+    costs.reserve(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+        if (auto it = previous_.find(files[i]); it != previous_.end())
+        {
+            costs.emplace_back(static_cast<double>(it->second), i);
+        }
+        else
+        {
+            costs.emplace_back(static_cast<double>(sizes[i]) * rate, i);
+        }
+    }
+    std::ranges::stable_sort(costs,
+        [](auto const& lhs, auto const& rhs)
+        {
+            return lhs.first > rhs.first;
+        });
+
+    std::vector<std::string> ordered;
+    ordered.reserve(files.size());
+    for (auto const& [cost, i] : costs)
+    {
+        ordered.push_back(std::move(files[i]));
+    }
+    files = std::move(ordered);
+}
+
+void
+TranslationUnitSchedule::
+record(
+    std::string_view const file,
+    clock_type::time_point const start,
+    clock_type::time_point const end)
+{
+    auto const duration = end - start;
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_.insert_or_assign(std::string(file),
+        std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+    if (!last_ || last_->End < end)
+    {
+        last_ = Extraction{ std::string(file), duration, end };
+    }
+}
+
+auto
+TranslationUnitSchedule::
+last() const ->
+    std::optional<Extraction>
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_;
+}
+
+Expected<void>
+TranslationUnitSchedule::
+save() const
+{
+    if (path_.empty())
+    {
+        return {};
+    }
+
+    // Sorted, so the file does not change
+    // when the durations are the same
+    std::map<std::string_view, std::int64_t> durations;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto const& [file, us] : previous_)
+        {
+            durations.emplace(file, us);
+        }
+        for (auto const& [file, us] : current_)
+        {
+            durations.insert_or_assign(file, us);
+        }
+    }
+
+    std::string data;
+    {
+        llvm::raw_string_ostream os(data);
+        llvm::json::OStream J(os, 2);
+        J.object([&]
+        {
+            J.attributeObject("durations", [&]
+            {
+                for (auto const& [file, us] : durations)
+                {
+                    J.attribute(file, us);
+                }
+            });
+        });
+        os << '\n';
+    }
+
+    // Written to a temporary file which replaces the
+    // previous one, so a reader never sees a partial
+    // file when several runs store their durations
+    namespace fs = llvm::sys::fs;
+    MRDOCS_TRY(files::createDirectory(files::getParentDir(path_)));
+    int fd;
+    llvm::SmallString<128> tempPath;
+    if (auto ec = fs::createUniqueFile(path_ + ".%%%%%%.tmp", fd, tempPath))
+    {
+        return Unexpected(formatError(
+            "fs::createUniqueFile(\"{}\") returned \"{}\"", path_, ec));
+    }
+    {
+        llvm::raw_fd_ostream os(fd, true);
+        os << data;
+        os.close();
+        if (os.has_error())
+        {
+            auto const ec = os.error();
+            os.clear_error();
+            fs::remove(tempPath);
+            return Unexpected(formatError(
+                "writing \"{}\" returned \"{}\"", tempPath.str().str(), ec));
+        }
+    }
+    if (auto ec = fs::rename(tempPath, path_))
+    {
+        fs::remove(tempPath);
+        return Unexpected(formatError(
+            "fs::rename(\"{}\") returned \"{}\"", path_, ec));
+    }
+    return {};
+}
+
+} // mrdocs
+} // clang
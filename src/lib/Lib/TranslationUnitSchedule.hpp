@@ -0,0 +1,114 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_LIB_TRANSLATIONUNITSCHEDULE_HPP
+#define MRDOCS_LIB_LIB_TRANSLATIONUNITSCHEDULE_HPP
+
+#include <mrdocs/Support/Error.hpp>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** The order in which translation units are extracted.
+
+    Translation units are extracted longest first,
+    so a large translation unit does not start when
+    the other threads of the pool are about to
+    become idle.
+
+    The cost of a translation unit is the duration
+    of its extraction in a previous run, which is
+    stored in a file between runs. The cost of
+    a translation unit without a recorded duration
+    is estimated from the size of its source file.
+*/
+class TranslationUnitSchedule
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+
+    /** A translation unit extracted in this run.
+    */
+    struct Extraction
+    {
+        std::string Path;
+        clock_type::duration Duration{};
+        clock_type::time_point End{};
+    };
+
+private:
+    std::string path_;
+    std::unordered_map<std::string, std::int64_t> previous_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::int64_t> current_;
+    std::optional<Extraction> last_;
+
+public:
+    /** Constructor
+
+        The durations recorded in the file are
+        loaded. A file which does not exist or
+        which cannot be read is ignored.
+
+        @param path The file where the durations are
+        stored, or an empty string to not store them.
+    */
+    explicit
+    TranslationUnitSchedule(std::string path);
+
+    /** Sort the files by decreasing cost.
+
+        Files with the same cost keep their order.
+    */
+    void
+    order(std::vector<std::string>& files) const;
+
+    /** Record the extraction of a translation unit.
+
+        This function is thread-safe.
+    */
+    void
+    record(
+        std::string_view file,
+        clock_type::time_point start,
+        clock_type::time_point end);
+
+    /** Return the translation unit which finished last.
+
+        This translation unit is at the end of the
+        critical path of the extraction, since the
+        extraction could not complete before it.
+    */
+    std::optional<Extraction>
+    last() const;
+
+    /** Write the recorded durations to the file.
+
+        The durations of translation units which
+        were not extracted in this run, such as the
+        ones loaded from the cache, are preserved.
+    */
+    Expected<void>
+    save() const;
+};
+
+} // mrdocs
+} // clang
+
+#endif
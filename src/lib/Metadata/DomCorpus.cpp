@@ -14,10 +14,13 @@
 #include "lib/Support/LegibleNames.hpp"
 #include "lib/Dom/LazyObject.hpp"
 #include "lib/Dom/LazyArray.hpp"
+#include "lib/Dom/StringPool.hpp"
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Metadata/DomCorpus.hpp>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <variant>
 
 namespace clang {
@@ -25,12 +28,72 @@ namespace mrdocs {
 
 class DomCorpus::Impl
 {
-    using value_type = std::weak_ptr<dom::ObjectImpl>;
+    struct Entry
+    {
+        // the object, while it is referenced
+        std::weak_ptr<dom::ObjectImpl> weak;
+
+        // the object, while it is retained
+        std::shared_ptr<dom::ObjectImpl> strong;
+
+        // the position in the list of recently
+        // used symbols, if it is in the list
+        std::list<SymbolID>::iterator pos;
+        bool retained = false;
+    };
+
+    // A shard of the cache with its own lock,
+    // so threads rendering different symbols
+    // do not wait for each other.
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<SymbolID, Entry> map;
+        // recently used symbols, from the most recent
+        std::list<SymbolID> recent;
+        CacheStats stats;
+    };
+
+    static constexpr std::size_t shardCount = 64;
 
     DomCorpus const& domCorpus_;
     Corpus const& corpus_;
-    std::unordered_map<SymbolID, value_type> cache_;
-    std::mutex mutex_;
+    std::size_t shardCapacity_;
+    std::unique_ptr<Shard[]> shards_;
+    dom::StringPool strings_;
+
+    Shard&
+    shard(SymbolID const& id) const noexcept
+    {
+        return shards_[std::hash<SymbolID>()(id) % shardCount];
+    }
+
+    // Make the symbol the most recently used,
+    // and release the least recently used
+    // symbols over the capacity
+    void
+    retain(Shard& s, Entry& e, SymbolID const& id) const
+    {
+        if (e.retained)
+        {
+            s.recent.splice(s.recent.begin(), s.recent, e.pos);
+            return;
+        }
+        if (shardCapacity_ == 0)
+        {
+            return;
+        }
+        e.strong = e.weak.lock();
+        e.pos = s.recent.insert(s.recent.begin(), id);
+        e.retained = true;
+        if (s.recent.size() > shardCapacity_)
+        {
+            Entry& last = s.map.at(s.recent.back());
+            last.strong.reset();
+            last.retained = false;
+            s.recent.pop_back();
+        }
+    }
 
 public:
     Impl(
@@ -38,6 +101,9 @@ public:
         Corpus const& corpus)
         : domCorpus_(domCorpus)
         , corpus_(corpus)
+        , shardCapacity_(
+            (corpus.config->domCacheSize + shardCount - 1) / shardCount)
+        , shards_(std::make_unique<Shard[]>(shardCount))
     {
     }
 
@@ -62,21 +128,73 @@ public:
         if(! I)
             return {}; // VFALCO Hack
 
-        std::lock_guard<std::mutex> lock(mutex_);
-        auto it = cache_.find(id);
-        if(it == cache_.end())
+        Shard& s = shard(id);
+        bool rebuild = false;
         {
-            auto obj = create(*I);
-            cache_.insert(
-                { id, obj.impl() });
-            return obj;
+            std::lock_guard<std::mutex> lock(s.mutex);
+            auto it = s.map.find(id);
+            if (it != s.map.end())
+            {
+                if (auto sp = it->second.weak.lock())
+                {
+                    ++s.stats.hits;
+                    if (!I->isNamespace())
+                    {
+                        retain(s, it->second, id);
+                    }
+                    return dom::Object(sp);
+                }
+                rebuild = true;
+            }
         }
-        if(auto sp = it->second.lock())
-            return dom::Object(sp);
+
+        // The object is created without the lock,
+        // since creating it may look up other symbols
         auto obj = create(*I);
-        it->second = obj.impl();
+
+        std::lock_guard<std::mutex> lock(s.mutex);
+        Entry& e = s.map[id];
+        if (auto sp = e.weak.lock())
+        {
+            // Another thread created the object first
+            ++s.stats.hits;
+            return dom::Object(sp);
+        }
+        ++(rebuild ? s.stats.rebuilds : s.stats.misses);
+        e.weak = obj.impl();
+        if (I->isNamespace())
+        {
+            // Namespaces are the parents of most
+            // symbols, so they are always retained
+            e.strong = obj.impl();
+        }
+        else
+        {
+            retain(s, e, id);
+        }
         return obj;
     }
+
+    dom::String
+    intern(std::string_view str)
+    {
+        return strings_.intern(str);
+    }
+
+    CacheStats
+    stats() const
+    {
+        CacheStats result;
+        for (std::size_t i = 0; i < shardCount; ++i)
+        {
+            Shard& s = shards_[i];
+            std::lock_guard<std::mutex> lock(s.mutex);
+            result.hits += s.stats.hits;
+            result.misses += s.stats.misses;
+            result.rebuilds += s.stats.rebuilds;
+        }
+        return result;
+    }
 };
 
 DomCorpus::
@@ -123,6 +241,21 @@ get(SymbolID const& id) const
     return impl_->get(id);
 }
 
+dom::String
+DomCorpus::
+intern(std::string_view str) const
+{
+    return impl_->intern(str);
+}
+
+auto
+DomCorpus::
+cacheStats() const ->
+    CacheStats
+{
+    return impl_->stats();
+}
+
 dom::Value
 DomCorpus::
 getJavadoc(Javadoc const&) const
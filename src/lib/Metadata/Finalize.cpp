@@ -10,9 +10,11 @@
 
 #include "Finalize.hpp"
 #include "lib/Lib/Info.hpp"
-#include "lib/Support/NameParser.hpp"
+#include "lib/Support/Chrono.hpp"
 #include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/Error.hpp>
 #include <algorithm>
+#include <chrono>
 #include <ranges>
 #include <span>
 
@@ -25,22 +27,21 @@ namespace mrdocs {
     which do not exist.
 
     References which should always be valid are not checked.
+
+    The references in the documentation are resolved
+    separately from the other members. Name lookup reads
+    the members of other Info, so resolving references
+    while other threads remove the invalid SymbolIDs
+    would be a data race.
 */
 class Finalizer
 {
     InfoSet& info_;
-    SymbolLookup& lookup_;
+    SymbolLookup const& lookup_;
     Info* current_ = nullptr;
 
     bool resolveReference(doc::Reference& ref)
     {
-        auto parse_result = parseIdExpression(ref.string);
-        if(! parse_result)
-            return false;
-
-        if(parse_result->name.empty())
-            return false;
-
         auto is_acceptable = [&](const Info& I) -> bool
         {
             // if we are copying the documentation of the
@@ -51,33 +52,8 @@ class Finalizer
             return true;
         };
 
-        const Info* found = nullptr;
-        if(parse_result->qualified)
-        {
-            Info* context = current_;
-            std::vector<std::string_view> qualifier;
-            // KRYSTIAN FIXME: lookupQualified should accept
-            // std::vector<std::string> as the qualifier
-            for(auto& part : parse_result->qualifier)
-                qualifier.push_back(part);
-            if(parse_result->qualifier.empty())
-            {
-                MRDOCS_ASSERT(info_.contains(SymbolID::global));
-                context = info_.find(SymbolID::global)->get();
-            }
-            found = lookup_.lookupQualified(
-                context,
-                qualifier,
-                parse_result->name,
-                is_acceptable);
-        }
-        else
-        {
-            found = lookup_.lookupUnqualified(
-                current_,
-                parse_result->name,
-                is_acceptable);
-        }
+        const Info* found = lookup_.lookup(
+            current_, ref.string, is_acceptable);
 
         // prevent recursive documentation copies
         if(ref.kind == doc::Kind::copied &&
@@ -274,12 +250,27 @@ class Finalizer
 public:
     Finalizer(
         InfoSet& Info,
-        SymbolLookup& Lookup)
+        SymbolLookup const& Lookup)
         : info_(Info)
         , lookup_(Lookup)
     {
     }
 
+    /** Resolve the references in the documentation of an Info.
+
+        This only modifies the documentation of `I`.
+    */
+    void resolve(Info& I)
+    {
+        current_ = &I;
+        finalize(I.javadoc);
+    }
+
+    /** Remove the SymbolIDs of an Info which do not exist.
+
+        This only modifies the members of `I`
+        other than its documentation.
+    */
     void finalize(Info& I)
     {
         current_ = &I;
@@ -294,7 +285,6 @@ public:
             check(I.Parent);
         }
         check(I.Members);
-        finalize(I.javadoc);
         finalize(I.UsingDirectives);
         // finalize(I.Specializations);
     }
@@ -307,7 +297,6 @@ public:
             check(I.Parent);
         }
         check(I.Members);
-        finalize(I.javadoc);
         // finalize(I.Specializations);
         finalize(I.Template);
         finalize(I.Bases);
@@ -321,7 +310,6 @@ public:
             check(I.Parent);
         }
         check(I.Members);
-        finalize(I.javadoc);
         finalize(I.Primary);
         finalize(I.Args);
     }
@@ -333,7 +321,6 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
         finalize(I.Template);
         finalize(I.ReturnType);
         finalize(I.Params);
@@ -346,7 +333,6 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
         finalize(I.Template);
         finalize(I.Type);
     }
@@ -359,7 +345,6 @@ public:
             check(I.Parent);
         }
         check(I.Members);
-        finalize(I.javadoc);
         finalize(I.UnderlyingType);
     }
 
@@ -370,7 +355,6 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
         finalize(I.Type);
     }
 
@@ -381,7 +365,6 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
         finalize(I.Template);
         finalize(I.Type);
     }
@@ -393,7 +376,6 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
         finalize(I.FriendSymbol);
         finalize(I.FriendType);
     }
@@ -405,7 +387,6 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
         finalize(I.AliasedSymbol);
     }
 
@@ -416,7 +397,6 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
         finalize(I.Qualifier);
         finalize(I.UsingSymbols);
     }
@@ -428,7 +408,6 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
     }
 
     void
@@ -438,7 +417,6 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
         finalize(I.Template);
         finalize(I.Deduced);
         finalize(I.Params);
@@ -451,27 +429,90 @@ public:
         {
             check(I.Parent);
         }
-        finalize(I.javadoc);
         finalize(I.Template);
     }
 };
 
-/** Finalizes a set of Info.
+namespace {
 
-    This removes any references to SymbolIDs
-    which do not exist.
+/** Apply a function to every Info in parallel.
 
-    References which should always be valid are not checked.
+    The Info are partitioned in contiguous chunks,
+    a few for each thread, so the overhead of
+    submitting work stays small on large corpora.
 */
-void
-finalize(InfoSet& Info, SymbolLookup& Lookup)
+template<class F>
+Expected<void>
+forEachInfo(
+    std::vector<Info*> const& infos,
+    ThreadPool& threadPool,
+    F const& f)
 {
-    Finalizer visitor(Info, Lookup);
+    std::size_t const chunks = std::min<std::size_t>(
+        infos.size(), threadPool.getThreadCount() * 8);
+    if(chunks == 0)
+        return {};
+    TaskGroup taskGroup(threadPool);
+    for(std::size_t i = 0; i < chunks; ++i)
+    {
+        std::size_t const first = infos.size() * i / chunks;
+        std::size_t const last = infos.size() * (i + 1) / chunks;
+        taskGroup.async(
+            [&infos, &f, first, last]
+            {
+                for(std::size_t j = first; j < last; ++j)
+                    f(*infos[j]);
+            });
+    }
+    auto errors = taskGroup.wait();
+    if(! errors.empty())
+        return Unexpected(Error(errors));
+    return {};
+}
+
+} // (anon)
+
+Expected<void>
+finalize(
+    InfoSet& Info,
+    SymbolLookup const& Lookup,
+    ThreadPool& threadPool)
+{
+    using clock_type = std::chrono::steady_clock;
+
+    std::vector<mrdocs::Info*> infos;
+    infos.reserve(Info.size());
     for(auto& I : Info)
     {
         MRDOCS_ASSERT(I);
-        visitor.finalize(*I);
+        infos.push_back(I.get());
     }
+
+    // Name lookup only reads the members which are
+    // finalized in the second phase, so every reference
+    // must be resolved before any of them are modified.
+    auto start_time = clock_type::now();
+    MRDOCS_TRY(forEachInfo(infos, threadPool,
+        [&](mrdocs::Info& I)
+        {
+            Finalizer(Info, Lookup).resolve(I);
+        }));
+    report::debug(
+        "Resolved the references of {} declarations in {}",
+        infos.size(),
+        format_duration(clock_type::now() - start_time));
+
+    start_time = clock_type::now();
+    MRDOCS_TRY(forEachInfo(infos, threadPool,
+        [&](mrdocs::Info& I)
+        {
+            Finalizer(Info, Lookup).finalize(I);
+        }));
+    report::debug(
+        "Removed the invalid symbol IDs of {} declarations in {}",
+        infos.size(),
+        format_duration(clock_type::now() - start_time));
+    return {};
 }
 
 } // mrdocs
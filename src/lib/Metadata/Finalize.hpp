@@ -13,13 +13,30 @@
 
 #include "lib/Lib/Info.hpp"
 #include "lib/Lib/Lookup.hpp"
+#include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
 
 namespace clang {
 namespace mrdocs {
 
+/** Finalizes a set of Info.
+
+    This resolves the references in the documentation
+    and removes any references to SymbolIDs which do
+    not exist. The Info are finalized in parallel,
+    and the time spent in each phase is reported
+    at the debug level.
+
+    @param Info The set of Info to finalize.
+    @param Lookup The lookup tables of the corpus.
+    @param threadPool The thread pool to use.
+*/
 MRDOCS_DECL
-void
-finalize(InfoSet& Info, SymbolLookup& Lookup);
+Expected<void>
+finalize(
+    InfoSet& Info,
+    SymbolLookup const& Lookup,
+    ThreadPool& threadPool);
 
 } // mrdocs
 } // clang
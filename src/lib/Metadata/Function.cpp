@@ -157,9 +157,9 @@ tag_invoke(
     Param const& p,
     DomCorpus const*)
 {
-    io.map("name", dom::stringOrNull(p.Name));
+    io.defer("name", [&]{ return dom::stringOrNull(p.Name); });
     io.map("type", p.Type);
-    io.map("default", dom::stringOrNull(p.Default));
+    io.defer("default", [&]{ return dom::stringOrNull(p.Default); });
 }
 
 void
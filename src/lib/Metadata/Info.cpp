@@ -67,7 +67,7 @@ tag_invoke(
     io.map("id", I.id);
     if (!I.Name.empty())
     {
-        io.map("name", I.Name);
+        io.defer("name", [&I, domCorpus]{ return domCorpus->intern(I.Name); });
     }
     io.map("kind", I.Kind);
     io.map("access", I.Access);
@@ -84,9 +84,8 @@ tag_invoke(
             // A convenient list to iterate over the parents
             // with resorting to partial template recursion
             Corpus const& corpus = domCorpus->getCorpus();
-            auto pIds = getParents(corpus, I);
             dom::Array res;
-            for (auto const& id : pIds)
+            for (auto const& id : corpus.parents(I))
             {
                 Info const& PI = corpus.get(id);
                 res.push_back(domCorpus->construct(PI));
@@ -101,7 +100,7 @@ tag_invoke(
     using T = std::remove_cvref_t<InfoTy>;
     if constexpr(std::derived_from<T, ScopeInfo>)
     {
-        io.map("members", dom::LazyArray(I.Members, domCorpus));
+        io.defer("members", [&]{ return dom::LazyArray(I.Members, domCorpus); });
         io.defer("overloads", [&]{
             // Eager array with overloadset or symbol
             return generateScopeOverloadsArray(I, *domCorpus);
@@ -118,14 +117,14 @@ tag_invoke(
             auto t = std::make_shared<Tranche>(makeTranche(I, **domCorpus));
             return dom::ValueFrom(t, domCorpus);
         });
-        io.map("usingDirectives", dom::LazyArray(I.UsingDirectives, domCorpus));
+        io.defer("usingDirectives", [&]{ return dom::LazyArray(I.UsingDirectives, domCorpus); });
     }
     if constexpr (T::isRecord())
     {
         io.map("tag", I.KeyKind);
         io.map("defaultAccess", getDefaultAccessString(I.KeyKind));
         io.map("isTypedef", I.IsTypeDef);
-        io.map("bases", dom::LazyArray(I.Bases, domCorpus));
+        io.defer("bases", [&]{ return dom::LazyArray(I.Bases, domCorpus); });
         io.defer("interface", [domCorpus, &I] {
             // Eager object with each Info type for each access specifier
             auto sp = std::make_shared<Interface>(makeInterface(I, domCorpus->getCorpus()));
@@ -169,7 +168,7 @@ tag_invoke(
             io.map("refQualifier", I.RefQualifier);
         }
         io.map("class", I.Class);
-        io.map("params", dom::LazyArray(I.Params, domCorpus));
+        io.defer("params", [&]{ return dom::LazyArray(I.Params, domCorpus); });
         io.map("return", I.ReturnType);
         io.map("template", I.Template);
         io.map("overloadedOperator", I.OverloadedOperator);
@@ -179,7 +178,7 @@ tag_invoke(
         {
             io.map("requires", I.Requires.Written);
         }
-        io.map("attributes", dom::LazyArray(I.Attributes));
+        io.defer("attributes", [&]{ return dom::LazyArray(I.Attributes); });
     }
     if constexpr (T::isTypedef())
     {
@@ -223,7 +222,7 @@ tag_invoke(
         {
             io.map("bitfieldWidth", I.BitfieldWidth.Written);
         }
-        io.map("attributes", dom::LazyArray(I.Attributes));
+        io.defer("attributes", [&]{ return dom::LazyArray(I.Attributes); });
     }
     if constexpr (T::isSpecialization())
     {}
@@ -252,7 +251,7 @@ tag_invoke(
     if constexpr (T::isUsing())
     {
         io.map("class", I.Class);
-        io.map("shadows", dom::LazyArray(I.UsingSymbols, domCorpus));
+        io.defer("shadows", [&]{ return dom::LazyArray(I.UsingSymbols, domCorpus); });
         io.map("qualifier", I.Qualifier);
     }
     if constexpr (T::isEnumConstant())
@@ -264,7 +263,7 @@ tag_invoke(
     }
     if constexpr (T::isGuide())
     {
-        io.map("params", dom::LazyArray(I.Params, domCorpus));
+        io.defer("params", [&]{ return dom::LazyArray(I.Params, domCorpus); });
         io.map("deduced", I.Deduced);
         io.map("template", I.Template);
         io.map("explicitSpec", I.Explicit);
@@ -109,11 +109,11 @@ tag_invoke(
     io.map("kind", I.Kind);
     visit(I, [domCorpus, &io]<typename T>(const T& t)
     {
-        io.map("name", t.Name);
+        io.defer("name", [&]{ return domCorpus->intern(t.Name); });
         io.map("symbol", t.id);
         if constexpr(requires { t.TemplateArgs; })
         {
-            io.map("args", dom::LazyArray(t.TemplateArgs, domCorpus));
+            io.defer("args", [&]{ return dom::LazyArray(t.TemplateArgs, domCorpus); });
         }
         io.map("prefix", t.Prefix);
     });
@@ -41,7 +41,7 @@ tag_invoke(
 {
     io.map("access", I.Access);
     io.map("isVirtual", I.IsVirtual);
-    io.map("type", dom::ValueFrom(I.Type, domCorpus));
+    io.defer("type", [&]{ return dom::ValueFrom(I.Type, domCorpus); });
 }
 
 void
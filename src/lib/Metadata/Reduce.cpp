@@ -13,6 +13,7 @@
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Platform.hpp>
 #include <llvm/ADT/STLExtras.h>
+#include <unordered_set>
 
 namespace clang {
 namespace mrdocs {
@@ -27,8 +28,8 @@ struct LocationEqual
         Location const& L1) const noexcept
     {
         return
-            std::tie(L0.LineNumber, L0.Filename) ==
-            std::tie(L1.LineNumber, L1.Filename);
+            std::tie(L0.LineNumber, L0.FileId) ==
+            std::tie(L1.LineNumber, L1.FileId);
     }
 };
 
@@ -38,13 +39,31 @@ struct LocationLess
     // No specific order (attributes more important than others) is required. Any
     // sort is enough, the order is only needed to call std::unique after sorting
     // the vector.
+    //
+    // The IDs of the files depend on the order in which
+    // the translation units are visited, so locations in
+    // different files on the same line are ordered by
+    // the key of their files to keep the output
+    // deterministic. Two files have the same key
+    // if and only if they have the same ID, so this
+    // order is consistent with LocationEqual.
     bool operator()(
         Location const& L0,
         Location const& L1) const noexcept
     {
+        if (L0.LineNumber != L1.LineNumber)
+        {
+            return L0.LineNumber < L1.LineNumber;
+        }
+        if (L0.FileId == L1.FileId)
+        {
+            return false;
+        }
+        SourceFile const F0 = L0.file();
+        SourceFile const F1 = L1.file();
         return
-            std::tie(L0.LineNumber, L0.Filename) <
-            std::tie(L1.LineNumber, L1.Filename);
+            std::tie(F0.Filename, F0.Path, F0.Kind) <
+            std::tie(F1.Filename, F1.Path, F1.Kind);
     }
 };
 
@@ -53,12 +72,30 @@ reduceSymbolIDs(
     std::vector<SymbolID>& list,
     std::vector<SymbolID>&& otherList)
 {
+    // A linear search is faster for small lists
+    if(list.size() * otherList.size() <= 1024)
+    {
+        for(auto const& id : otherList)
+        {
+            auto it = llvm::find(list, id);
+            if(it != list.end())
+                continue;
+            list.push_back(id);
+        }
+        return;
+    }
+
+    // Merging the members of the same scope from
+    // every translation unit would be quadratic
+    // with a linear search, so the IDs are looked
+    // up in a set, keeping the first-seen order.
+    std::unordered_set<SymbolID> seen;
+    seen.reserve(list.size() + otherList.size());
+    seen.insert(list.begin(), list.end());
     for(auto const& id : otherList)
     {
-        auto it = llvm::find(list, id);
-        if(it != list.end())
-            continue;
-        list.push_back(id);
+        if(seen.insert(id).second)
+            list.push_back(id);
     }
 }
 
@@ -0,0 +1,905 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "Serialize.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+[[noreturn]]
+void
+malformed(std::string_view what)
+{
+    formatError("malformed binary metadata: {}", what).Throw();
+}
+
+//------------------------------------------------
+//
+// Members
+//
+// Each function maps the members declared by
+// one type. The same function is used to encode
+// and decode, so the two cannot disagree.
+//
+//------------------------------------------------
+
+template<class Ar>
+void fields(Ar& ar, ExprInfo& I)
+{
+    ar(I.Written);
+}
+
+template<class Ar, class T>
+void fields(Ar& ar, ConstantExprInfo<T>& I)
+{
+    ar(I.Written, I.Value);
+}
+
+template<class Ar>
+void fields(Ar& ar, NoexceptInfo& I)
+{
+    ar(I.Implicit, I.Kind, I.Operand);
+}
+
+template<class Ar>
+void fields(Ar& ar, ExplicitInfo& I)
+{
+    ar(I.Implicit, I.Kind, I.Operand);
+}
+
+template<class Ar>
+void fields(Ar& ar, BaseInfo& I)
+{
+    ar(I.Type, I.Access, I.IsVirtual);
+}
+
+template<class Ar>
+void fields(Ar& ar, Param& I)
+{
+    ar(I.Type, I.Name, I.Default);
+}
+
+template<class Ar>
+void fields(Ar& ar, TemplateInfo& I)
+{
+    ar(I.Params, I.Args, I.Requires, I.Primary);
+}
+
+// Types
+
+template<class Ar>
+void fields(Ar& ar, NamedTypeInfo& I)
+{
+    ar(I.CVQualifiers, I.Name);
+}
+
+template<class Ar>
+void fields(Ar& ar, DecltypeTypeInfo& I)
+{
+    ar(I.CVQualifiers, I.Operand);
+}
+
+template<class Ar>
+void fields(Ar& ar, AutoTypeInfo& I)
+{
+    ar(I.CVQualifiers, I.Keyword, I.Constraint);
+}
+
+template<class Ar>
+void fields(Ar& ar, LValueReferenceTypeInfo& I)
+{
+    ar(I.PointeeType);
+}
+
+template<class Ar>
+void fields(Ar& ar, RValueReferenceTypeInfo& I)
+{
+    ar(I.PointeeType);
+}
+
+template<class Ar>
+void fields(Ar& ar, PointerTypeInfo& I)
+{
+    ar(I.CVQualifiers, I.PointeeType);
+}
+
+template<class Ar>
+void fields(Ar& ar, MemberPointerTypeInfo& I)
+{
+    ar(I.CVQualifiers, I.ParentType, I.PointeeType);
+}
+
+template<class Ar>
+void fields(Ar& ar, ArrayTypeInfo& I)
+{
+    ar(I.ElementType, I.Bounds);
+}
+
+template<class Ar>
+void fields(Ar& ar, FunctionTypeInfo& I)
+{
+    ar(I.ReturnType, I.ParamTypes, I.CVQualifiers,
+        I.RefQualifier, I.ExceptionSpec, I.IsVariadic);
+}
+
+// Template arguments and parameters
+
+template<class Ar>
+void fields(Ar& ar, TypeTArg& I)
+{
+    ar(I.Type);
+}
+
+template<class Ar>
+void fields(Ar& ar, NonTypeTArg& I)
+{
+    ar(I.Value);
+}
+
+template<class Ar>
+void fields(Ar& ar, TemplateTArg& I)
+{
+    ar(I.Template, I.Name);
+}
+
+template<class Ar>
+void fields(Ar& ar, TypeTParam& I)
+{
+    ar(I.KeyKind, I.Constraint);
+}
+
+template<class Ar>
+void fields(Ar& ar, NonTypeTParam& I)
+{
+    ar(I.Type);
+}
+
+template<class Ar>
+void fields(Ar& ar, TemplateTParam& I)
+{
+    ar(I.Params);
+}
+
+// Javadoc
+
+template<class Ar, class NodeTy>
+void docFields(Ar& ar, NodeTy& N)
+{
+    if constexpr(std::derived_from<NodeTy, doc::Text>)
+        ar(N.string);
+    if constexpr(std::derived_from<NodeTy, doc::Block>)
+        ar(N.children);
+    if constexpr(std::derived_from<NodeTy, doc::Reference>)
+        ar(N.id);
+    if constexpr(std::same_as<NodeTy, doc::Styled>)
+        ar(N.style);
+    if constexpr(std::same_as<NodeTy, doc::Link>)
+        ar(N.href);
+    if constexpr(std::same_as<NodeTy, doc::Copied>)
+        ar(N.parts);
+    if constexpr(std::same_as<NodeTy, doc::Heading>)
+        ar(N.string);
+    if constexpr(std::same_as<NodeTy, doc::Admonition>)
+        ar(N.admonish);
+    if constexpr(std::same_as<NodeTy, doc::Param>)
+        ar(N.name, N.direction);
+    if constexpr(std::same_as<NodeTy, doc::TParam>)
+        ar(N.name);
+    if constexpr(std::same_as<NodeTy, doc::Throws>)
+        ar(N.exception);
+}
+
+// Symbols
+
+template<class Ar>
+void fields(Ar& ar, NamespaceInfo& I)
+{
+    ar(I.IsInline, I.IsAnonymous, I.UsingDirectives);
+}
+
+template<class Ar>
+void fields(Ar& ar, RecordInfo& I)
+{
+    ar(I.KeyKind, I.Template, I.IsTypeDef, I.IsFinal,
+        I.IsFinalDestructor, I.Bases);
+}
+
+template<class Ar>
+void fields(Ar& ar, FunctionInfo& I)
+{
+    ar(I.ReturnType, I.Params, I.Template, I.Class,
+        I.Noexcept, I.Explicit, I.Requires);
+    ar(I.IsVariadic, I.IsVirtual, I.IsVirtualAsWritten,
+        I.IsPure, I.IsDefaulted, I.IsExplicitlyDefaulted,
+        I.IsDeleted, I.IsDeletedAsWritten, I.IsNoReturn,
+        I.HasOverrideAttr, I.HasTrailingReturn, I.IsConst,
+        I.IsVolatile, I.IsFinal, I.IsNodiscard,
+        I.IsExplicitObjectMemberFunction);
+    ar(I.Constexpr, I.OverloadedOperator, I.StorageClass,
+        I.RefQualifier, I.Attributes);
+}
+
+template<class Ar>
+void fields(Ar& ar, EnumInfo& I)
+{
+    ar(I.Scoped, I.UnderlyingType);
+}
+
+template<class Ar>
+void fields(Ar& ar, EnumConstantInfo& I)
+{
+    ar(I.Initializer);
+}
+
+template<class Ar>
+void fields(Ar& ar, TypedefInfo& I)
+{
+    ar(I.Type, I.IsUsing, I.Template);
+}
+
+template<class Ar>
+void fields(Ar& ar, VariableInfo& I)
+{
+    ar(I.Type, I.Template, I.Initializer, I.StorageClass,
+        I.Constexpr, I.IsConstinit, I.IsThreadLocal);
+}
+
+template<class Ar>
+void fields(Ar& ar, FieldInfo& I)
+{
+    ar(I.Type, I.Default, I.IsVariant, I.IsMutable,
+        I.IsBitfield, I.BitfieldWidth, I.IsMaybeUnused,
+        I.IsDeprecated, I.HasNoUniqueAddress, I.Attributes);
+}
+
+template<class Ar>
+void fields(Ar& ar, SpecializationInfo& I)
+{
+    ar(I.Args, I.Primary);
+}
+
+template<class Ar>
+void fields(Ar& ar, FriendInfo& I)
+{
+    ar(I.FriendSymbol, I.FriendType);
+}
+
+template<class Ar>
+void fields(Ar& ar, GuideInfo& I)
+{
+    ar(I.Deduced, I.Template, I.Params, I.Explicit);
+}
+
+template<class Ar>
+void fields(Ar& ar, NamespaceAliasInfo& I)
+{
+    ar(I.AliasedSymbol);
+}
+
+template<class Ar>
+void fields(Ar& ar, UsingInfo& I)
+{
+    ar(I.Class, I.UsingSymbols, I.Qualifier);
+}
+
+template<class Ar>
+void fields(Ar& ar, ConceptInfo& I)
+{
+    ar(I.Template, I.Constraint);
+}
+
+/** Map the members of an Info, excluding the kind and ID.
+*/
+template<class Ar, class InfoTy>
+void infoFields(Ar& ar, InfoTy& I)
+{
+    ar(I.Name, I.Access, I.Extraction, I.Parent, I.javadoc);
+    if constexpr(std::derived_from<InfoTy, SourceInfo>)
+        ar(I.DefLoc, I.Loc);
+    if constexpr(std::derived_from<InfoTy, ScopeInfo>)
+        ar(I.Members, I.Lookups);
+    fields(ar, I);
+}
+
+//------------------------------------------------
+//
+// Enumerations
+//
+// The first and the last value of each
+// enumeration. A decoded value outside of
+// this range is malformed.
+//
+//------------------------------------------------
+
+#define MRDOCS_ENUM_RANGE(E, First, Last) \
+    constexpr std::pair<E, E> enumRange(E) noexcept \
+    { return { E::First, E::Last }; }
+
+MRDOCS_ENUM_RANGE(AccessKind, None, Private)
+MRDOCS_ENUM_RANGE(AutoKind, Auto, DecltypeAuto)
+MRDOCS_ENUM_RANGE(ConstexprKind, None, Consteval)
+MRDOCS_ENUM_RANGE(ExplicitKind, False, Dependent)
+MRDOCS_ENUM_RANGE(ExtractionMode, Dependency, ImplementationDefined)
+MRDOCS_ENUM_RANGE(FileKind, Source, Other)
+MRDOCS_ENUM_RANGE(FunctionClass, Normal, Destructor)
+MRDOCS_ENUM_RANGE(NameKind, Identifier, Specialization)
+MRDOCS_ENUM_RANGE(NoexceptKind, False, Dependent)
+MRDOCS_ENUM_RANGE(OperatorKind, None, Coawait)
+MRDOCS_ENUM_RANGE(RecordKeyKind, Struct, Union)
+MRDOCS_ENUM_RANGE(ReferenceKind, None, RValue)
+MRDOCS_ENUM_RANGE(StorageClassKind, None, Register)
+MRDOCS_ENUM_RANGE(TArgKind, Type, Template)
+MRDOCS_ENUM_RANGE(TParamKeyKind, Class, Typename)
+MRDOCS_ENUM_RANGE(TParamKind, Type, Template)
+MRDOCS_ENUM_RANGE(TypeKind, Named, Function)
+MRDOCS_ENUM_RANGE(UsingClass, Normal, Enum)
+MRDOCS_ENUM_RANGE(doc::Admonish, none, warning)
+MRDOCS_ENUM_RANGE(doc::Kind, text, postcondition)
+MRDOCS_ENUM_RANGE(doc::ParamDirection, none, inout)
+MRDOCS_ENUM_RANGE(doc::Parts, all, description)
+MRDOCS_ENUM_RANGE(doc::Style, none, italic)
+
+#undef MRDOCS_ENUM_RANGE
+
+// The qualifiers are flags
+constexpr
+std::pair<QualifierKind, QualifierKind>
+enumRange(QualifierKind) noexcept
+{
+    return { QualifierKind::None,
+        static_cast<QualifierKind>(
+            QualifierKind::Const | QualifierKind::Volatile) };
+}
+
+constexpr
+std::pair<InfoKind, InfoKind>
+enumRange(InfoKind) noexcept
+{
+    InfoKind last = InfoKind::None;
+    #define INFO(Type) last = InfoKind::Type;
+    #include <mrdocs/Metadata/InfoNodesPascal.inc>
+    return { InfoKind::None, last };
+}
+
+//------------------------------------------------
+
+/** Create an object of the derived type matching a kind.
+*/
+template<class Base, class... Derived, class Kind>
+std::unique_ptr<Base>
+makeByKind(Kind kind)
+{
+    std::unique_ptr<Base> p;
+    ((kind == Derived::kind_id &&
+        (p = std::make_unique<Derived>(), true)) || ...);
+    if(! p)
+        malformed("unknown kind");
+    return p;
+}
+
+//------------------------------------------------
+
+/** Writes every member it is applied to.
+
+    The members are taken by non-const reference
+    so the member maps can be shared with the
+    decoder. The encoder never modifies them.
+*/
+struct Encoder
+{
+    BinaryWriter& w;
+
+    template<class T>
+    void operator()(T& v)
+    {
+        if constexpr(std::same_as<T, bool>)
+            w.writeUInt(v ? 1 : 0);
+        else if constexpr(std::unsigned_integral<T>)
+            w.writeUInt(v);
+        else if constexpr(std::is_enum_v<T>)
+            w.writeUInt(static_cast<std::uint64_t>(v));
+        else
+            fields(*this, v);
+    }
+
+    template<class T0, class T1, class... Tn>
+    void operator()(T0& v0, T1& v1, Tn&... vn)
+    {
+        (*this)(v0);
+        (*this)(v1);
+        ((*this)(vn), ...);
+    }
+
+    void operator()(std::string& s)
+    {
+        w.writeString(s);
+    }
+
+    void operator()(SymbolID& id)
+    {
+        w.writeSymbolID(id);
+    }
+
+    // The file of a location is written by
+    // value, since the IDs of the file table
+    // are only meaningful in this process
+    void operator()(Location& loc)
+    {
+        SourceFile const file = loc.file();
+        w.writeString(file.Path);
+        w.writeString(file.Filename);
+        w.writeUInt(loc.LineNumber);
+        w.writeUInt(static_cast<std::uint64_t>(file.Kind));
+        w.writeUInt(loc.Documented ? 1 : 0);
+    }
+
+    void operator()(OptionalLocation& v)
+    {
+        w.writeUInt(v.has_value());
+        if(v)
+            (*this)(*v);
+    }
+
+    template<class T>
+    void operator()(std::optional<T>& v)
+    {
+        w.writeUInt(v.has_value());
+        if(v)
+            (*this)(*v);
+    }
+
+    template<class T>
+    void operator()(std::vector<T>& v)
+    {
+        w.writeUInt(v.size());
+        for(auto& e : v)
+            (*this)(e);
+    }
+
+    // The entries are written in the order of
+    // their keys, so equal maps are written
+    // as the same bytes
+    template<class K, class V>
+    void operator()(std::unordered_map<K, V>& m)
+    {
+        std::vector<typename std::unordered_map<K, V>::value_type*> entries;
+        entries.reserve(m.size());
+        for(auto& e : m)
+            entries.push_back(&e);
+        std::ranges::sort(entries, std::less<>(),
+            [](auto const* e) -> K const& { return e->first; });
+        w.writeUInt(entries.size());
+        for(auto* e : entries)
+        {
+            K key = e->first;
+            (*this)(key, e->second);
+        }
+    }
+
+    template<class T>
+    void operator()(std::unique_ptr<T>& p)
+    {
+        w.writeUInt(p != nullptr);
+        if(p)
+            node(*p);
+    }
+
+    void node(TypeInfo& I)
+    {
+        (*this)(I.Kind, I.IsPackExpansion);
+        visit(I, [&](auto& U) { fields(*this, U); });
+    }
+
+    void node(NameInfo& I)
+    {
+        (*this)(I.Kind, I.id, I.Name, I.Prefix);
+        if(I.isSpecialization())
+            (*this)(static_cast<SpecializationNameInfo&>(I).TemplateArgs);
+    }
+
+    void node(TArg& I)
+    {
+        (*this)(I.Kind, I.IsPackExpansion);
+        visit(I, [&](auto& U) { fields(*this, U); });
+    }
+
+    void node(TParam& I)
+    {
+        (*this)(I.Kind, I.Name, I.IsParameterPack, I.Default);
+        visit(I, [&](auto& U) { fields(*this, U); });
+    }
+
+    template<std::derived_from<doc::Node> NodeTy>
+    void node(NodeTy& I)
+    {
+        (*this)(I.kind);
+        doc::visit(I, [&](auto& U) { docFields(*this, U); });
+    }
+
+    void node(Javadoc& I)
+    {
+        (*this)(I.getBlocks());
+    }
+
+    void node(Info& I)
+    {
+        (*this)(I.Kind, I.id);
+        visit(I, [&](auto& U) { infoFields(*this, U); });
+    }
+};
+
+//------------------------------------------------
+
+/** Reads every member it is applied to.
+*/
+struct Decoder
+{
+    BinaryReader& r;
+
+    template<class T>
+    void operator()(T& v)
+    {
+        if constexpr(std::same_as<T, bool>)
+        {
+            auto const n = r.readUInt();
+            if(n > 1)
+                malformed("invalid bool");
+            v = n != 0;
+        }
+        else if constexpr(std::unsigned_integral<T>)
+        {
+            v = static_cast<T>(r.readUInt());
+        }
+        else if constexpr(std::is_enum_v<T>)
+        {
+            constexpr auto range = enumRange(T{});
+            auto const n = r.readUInt();
+            if(n < static_cast<std::uint64_t>(range.first) ||
+                n > static_cast<std::uint64_t>(range.second))
+                malformed("invalid enumerator");
+            v = static_cast<T>(n);
+        }
+        else
+        {
+            fields(*this, v);
+        }
+    }
+
+    template<class T0, class T1, class... Tn>
+    void operator()(T0& v0, T1& v1, Tn&... vn)
+    {
+        (*this)(v0);
+        (*this)(v1);
+        ((*this)(vn), ...);
+    }
+
+    void operator()(std::string& s)
+    {
+        s = r.readString();
+    }
+
+    void operator()(SymbolID& id)
+    {
+        id = r.readSymbolID();
+    }
+
+    bool present()
+    {
+        bool b;
+        (*this)(b);
+        return b;
+    }
+
+    void operator()(Location& loc)
+    {
+        std::string_view const path = r.readString();
+        std::string_view const filename = r.readString();
+        unsigned line;
+        FileKind kind;
+        bool documented;
+        (*this)(line, kind, documented);
+        loc = Location(path, filename, line, kind, documented);
+    }
+
+    void operator()(OptionalLocation& v)
+    {
+        v.reset();
+        if(present())
+            (*this)(v.emplace());
+    }
+
+    template<class T>
+    void operator()(std::optional<T>& v)
+    {
+        v.reset();
+        if(present())
+            (*this)(v.emplace());
+    }
+
+    template<class T>
+    void operator()(std::vector<T>& v)
+    {
+        auto const n = r.readCount();
+        v.clear();
+        v.reserve(n);
+        for(std::uint64_t i = 0; i < n; ++i)
+            (*this)(v.emplace_back());
+    }
+
+    template<class K, class V>
+    void operator()(std::unordered_map<K, V>& m)
+    {
+        auto const n = r.readCount();
+        m.clear();
+        m.reserve(n);
+        for(std::uint64_t i = 0; i < n; ++i)
+        {
+            K key;
+            V value;
+            (*this)(key, value);
+            m.emplace(std::move(key), std::move(value));
+        }
+    }
+
+    template<class T>
+    void operator()(std::unique_ptr<T>& p)
+    {
+        p.reset();
+        if(present())
+            node(p);
+    }
+
+    void node(std::unique_ptr<TypeInfo>& p)
+    {
+        TypeKind kind;
+        (*this)(kind);
+        p = makeByKind<TypeInfo,
+            NamedTypeInfo,
+            DecltypeTypeInfo,
+            AutoTypeInfo,
+            LValueReferenceTypeInfo,
+            RValueReferenceTypeInfo,
+            PointerTypeInfo,
+            MemberPointerTypeInfo,
+            ArrayTypeInfo,
+            FunctionTypeInfo>(kind);
+        (*this)(p->IsPackExpansion);
+        visit(*p, [&](auto& U) { fields(*this, U); });
+    }
+
+    void node(std::unique_ptr<NameInfo>& p)
+    {
+        NameKind kind;
+        (*this)(kind);
+        if(kind == NameKind::Identifier)
+            p = std::make_unique<NameInfo>();
+        else if(kind == NameKind::Specialization)
+            p = std::make_unique<SpecializationNameInfo>();
+        else
+            malformed("unknown name kind");
+        (*this)(p->id, p->Name, p->Prefix);
+        if(p->isSpecialization())
+            (*this)(static_cast<SpecializationNameInfo&>(*p).TemplateArgs);
+    }
+
+    void node(std::unique_ptr<TArg>& p)
+    {
+        TArgKind kind;
+        (*this)(kind);
+        p = makeByKind<TArg,
+            TypeTArg,
+            NonTypeTArg,
+            TemplateTArg>(kind);
+        (*this)(p->IsPackExpansion);
+        visit(*p, [&](auto& U) { fields(*this, U); });
+    }
+
+    void node(std::unique_ptr<TParam>& p)
+    {
+        TParamKind kind;
+        (*this)(kind);
+        p = makeByKind<TParam,
+            TypeTParam,
+            NonTypeTParam,
+            TemplateTParam>(kind);
+        (*this)(p->Name, p->IsParameterPack, p->Default);
+        visit(*p, [&](auto& U) { fields(*this, U); });
+    }
+
+    template<std::derived_from<doc::Node> NodeTy>
+    void node(std::unique_ptr<NodeTy>& p)
+    {
+        doc::Kind kind;
+        (*this)(kind);
+        doc::visit(kind, [&]<class U>()
+        {
+            if constexpr(std::derived_from<U, NodeTy>)
+            {
+                auto n = std::make_unique<U>();
+                docFields(*this, *n);
+                p = std::move(n);
+            }
+            else
+            {
+                malformed("unexpected javadoc node");
+            }
+        });
+    }
+
+    void node(std::unique_ptr<Javadoc>& p)
+    {
+        doc::List<doc::Block> blocks;
+        (*this)(blocks);
+        p = std::make_unique<Javadoc>(std::move(blocks));
+    }
+
+    void node(std::unique_ptr<Info>& p)
+    {
+        InfoKind kind;
+        SymbolID id;
+        (*this)(kind, id);
+        switch(kind)
+        {
+        #define INFO(Type) \
+        case InfoKind::Type: \
+            p = std::make_unique<Type##Info>(id); \
+            break;
+        #include <mrdocs/Metadata/InfoNodesPascal.inc>
+        default:
+            malformed("unknown info kind");
+        }
+        visit(*p, [&](auto& U) { infoFields(*this, U); });
+    }
+};
+
+} // (anon)
+
+//------------------------------------------------
+
+void
+BinaryWriter::
+writeUInt(std::uint64_t value)
+{
+    do
+    {
+        auto byte = static_cast<unsigned char>(value & 0x7f);
+        value >>= 7;
+        if(value != 0)
+            byte |= 0x80;
+        out_.push_back(static_cast<char>(byte));
+    }
+    while(value != 0);
+}
+
+void
+BinaryWriter::
+writeString(std::string_view s)
+{
+    writeUInt(s.size());
+    out_.append(s);
+}
+
+void
+BinaryWriter::
+writeSymbolID(SymbolID const& id)
+{
+    out_.append(
+        reinterpret_cast<char const*>(id.data()),
+        id.size());
+}
+
+void
+BinaryWriter::
+writeInfo(Info const& I)
+{
+    Encoder enc{*this};
+    enc.node(const_cast<Info&>(I));
+}
+
+void
+BinaryWriter::
+writeInfoSet(InfoSet const& info)
+{
+    writeUInt(info.size());
+    for(auto const& I : info)
+        writeInfo(*I);
+}
+
+//------------------------------------------------
+
+std::uint64_t
+BinaryReader::
+readUInt()
+{
+    std::uint64_t value = 0;
+    for(unsigned shift = 0; shift < 64; shift += 7)
+    {
+        if(it_ == end_)
+            malformed("truncated integer");
+        auto const byte = static_cast<unsigned char>(*it_++);
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if(! (byte & 0x80))
+            return value;
+    }
+    malformed("integer too long");
+}
+
+std::string_view
+BinaryReader::
+readString()
+{
+    auto const n = readUInt();
+    if(n > static_cast<std::uint64_t>(end_ - it_))
+        malformed("truncated string");
+    std::string_view s(it_, n);
+    it_ += n;
+    return s;
+}
+
+SymbolID
+BinaryReader::
+readSymbolID()
+{
+    if(end_ - it_ < 20)
+        malformed("truncated symbol id");
+    SymbolID id(reinterpret_cast<std::uint8_t const*>(it_));
+    it_ += 20;
+    return id;
+}
+
+std::uint64_t
+BinaryReader::
+readCount()
+{
+    auto const n = readUInt();
+    if(n > remaining())
+        malformed("count larger than the data");
+    return n;
+}
+
+std::unique_ptr<Info>
+BinaryReader::
+readInfo()
+{
+    std::unique_ptr<Info> I;
+    Decoder dec{*this};
+    dec.node(I);
+    return I;
+}
+
+InfoSet
+BinaryReader::
+readInfoSet()
+{
+    auto const n = readCount();
+    InfoSet info;
+    info.reserve(n);
+    for(std::uint64_t i = 0; i < n; ++i)
+    {
+        if(! info.emplace(readInfo()).second)
+            malformed("duplicate symbol");
+    }
+    return info;
+}
+
+} // mrdocs
+} // clang
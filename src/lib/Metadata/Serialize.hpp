@@ -0,0 +1,139 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_METADATA_SERIALIZE_HPP
+#define MRDOCS_LIB_METADATA_SERIALIZE_HPP
+
+#include "lib/Lib/Info.hpp"
+#include <mrdocs/Metadata/Info.hpp>
+#include <mrdocs/Metadata/Symbols.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace clang {
+namespace mrdocs {
+
+/** The version of the binary metadata encoding.
+
+    This must be incremented whenever the encoding
+    of any metadata changes, including when members
+    are added to or removed from the metadata types.
+    Data written with a different version is rejected
+    by @ref BinaryReader.
+*/
+constexpr std::uint32_t binaryFormatVersion = 1;
+
+/** A writer for the binary metadata encoding.
+
+    Unsigned integers and enumerations are written
+    as LEB128 varints, strings are written as their
+    size followed by their bytes, and symbol IDs
+    are written as their 20 raw bytes.
+
+    Every member of the metadata is written, so
+    the value read back by @ref BinaryReader is
+    identical to the value which was written.
+*/
+class BinaryWriter
+{
+    std::string& out_;
+
+public:
+    /** Constructor.
+
+        @param out The buffer to append to.
+    */
+    explicit
+    BinaryWriter(std::string& out) noexcept
+        : out_(out)
+    {
+    }
+
+    void writeUInt(std::uint64_t value);
+    void writeString(std::string_view s);
+    void writeSymbolID(SymbolID const& id);
+
+    /** Write an Info and all of its members.
+    */
+    void writeInfo(Info const& I);
+
+    /** Write every Info in a set.
+    */
+    void writeInfoSet(InfoSet const& info);
+};
+
+/** A reader for the binary metadata encoding.
+
+    The reader does not own the data. Strings
+    returned by @ref readString refer to it.
+
+    All functions throw an `Exception` if the
+    data is truncated or malformed.
+*/
+class BinaryReader
+{
+    char const* it_;
+    char const* end_;
+
+public:
+    /** Constructor.
+
+        @param data The data to read from.
+    */
+    explicit
+    BinaryReader(std::string_view data) noexcept
+        : it_(data.data())
+        , end_(data.data() + data.size())
+    {
+    }
+
+    /** Return true if all the data was read.
+    */
+    bool
+    empty() const noexcept
+    {
+        return it_ == end_;
+    }
+
+    /** Return the number of bytes not read yet.
+    */
+    std::size_t
+    remaining() const noexcept
+    {
+        return static_cast<std::size_t>(end_ - it_);
+    }
+
+    std::uint64_t readUInt();
+    std::string_view readString();
+    SymbolID readSymbolID();
+
+    /** Read the number of elements of a sequence.
+
+        Each element takes at least one byte, so
+        a count larger than the remaining data
+        is malformed.
+    */
+    std::uint64_t readCount();
+
+    /** Read an Info written by @ref BinaryWriter::writeInfo.
+    */
+    std::unique_ptr<Info> readInfo();
+
+    /** Read a set written by @ref BinaryWriter::writeInfoSet.
+    */
+    InfoSet readInfoSet();
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -10,8 +10,16 @@
 //
 
 #include <mrdocs/Metadata/Source.hpp>
+#include <mrdocs/Support/Error.hpp>
 #include "lib/Dom/LazyObject.hpp"
 #include "lib/Dom/LazyArray.hpp"
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace clang {
 namespace mrdocs {
@@ -32,6 +40,146 @@ toString(FileKind kind)
     };
 }
 
+//------------------------------------------------
+
+// The files are stored in chunks which are never
+// moved, so they can be read without the lock
+// while other threads add files.
+struct FileTable::Impl
+{
+    static constexpr std::size_t chunkBits = 12;
+    static constexpr std::size_t chunkSize = std::size_t(1) << chunkBits;
+    static constexpr std::size_t maxChunks = std::size_t(1) << 12;
+
+    struct Entry
+    {
+        std::string path;
+        std::string filename;
+        FileKind kind = FileKind::Source;
+    };
+
+    // A file is identified by its path together
+    // with its short name and kind, which depend
+    // on the configuration of the corpus.
+    struct Key
+    {
+        std::string_view path;
+        std::string_view filename;
+        FileKind kind;
+
+        bool operator==(Key const&) const noexcept = default;
+    };
+
+    struct KeyHash
+    {
+        std::size_t
+        operator()(Key const& k) const noexcept
+        {
+            std::size_t h = std::hash<std::string_view>{}(k.path);
+            h ^= std::hash<std::string_view>{}(k.filename) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= static_cast<std::size_t>(k.kind) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    std::mutex mutex;
+    std::unordered_map<Key, std::uint32_t, KeyHash> ids;
+    std::array<std::atomic<Entry*>, maxChunks> chunks{};
+    std::atomic<std::uint32_t> size = 1;
+};
+
+FileTable::
+FileTable(Impl& impl) noexcept
+    : impl_(impl)
+{
+}
+
+FileTable&
+FileTable::
+instance() noexcept
+{
+    // Never destroyed, so the views returned
+    // by the table remain valid during exit
+    static FileTable* const table =
+        new FileTable(*new Impl);
+    return *table;
+}
+
+std::uint32_t
+FileTable::
+add(
+    std::string_view const path,
+    std::string_view const filename,
+    FileKind const kind)
+{
+    if (path.empty())
+    {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(impl_.mutex);
+    if (auto const it = impl_.ids.find({ path, filename, kind });
+        it != impl_.ids.end())
+    {
+        return it->second;
+    }
+    std::uint32_t const id = impl_.size.load(std::memory_order_relaxed);
+    std::size_t const chunk = id >> Impl::chunkBits;
+    if (chunk >= Impl::maxChunks)
+    {
+        Error("too many files in the file table").Throw();
+    }
+    Impl::Entry* entries = impl_.chunks[chunk].load(std::memory_order_relaxed);
+    if (!entries)
+    {
+        entries = new Impl::Entry[Impl::chunkSize];
+        impl_.chunks[chunk].store(entries, std::memory_order_release);
+    }
+    Impl::Entry& e = entries[id & (Impl::chunkSize - 1)];
+    e.path = path;
+    e.filename = filename;
+    e.kind = kind;
+    impl_.ids.emplace(Impl::Key{ e.path, e.filename, e.kind }, id);
+    impl_.size.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+SourceFile
+FileTable::
+get(std::uint32_t const id) const noexcept
+{
+    if (id == 0 ||
+        id >= impl_.size.load(std::memory_order_acquire))
+    {
+        return {};
+    }
+    Impl::Entry const& e =
+        impl_.chunks[id >> Impl::chunkBits].load(
+            std::memory_order_acquire)[id & (Impl::chunkSize - 1)];
+    return { e.path, e.filename, e.kind };
+}
+
+std::size_t
+FileTable::
+size() const noexcept
+{
+    return impl_.size.load(std::memory_order_acquire) - 1;
+}
+
+//------------------------------------------------
+
+Location::
+Location(
+    std::string_view const filepath,
+    std::string_view const filename,
+    unsigned const line,
+    FileKind const kind,
+    bool const documented)
+    : FileId(FileTable::instance().add(filepath, filename, kind))
+    , LineNumber(line)
+    , Documented(documented)
+{
+}
+
 template <class IO>
 void
 tag_invoke(
@@ -39,10 +187,11 @@ tag_invoke(
     IO& io,
     Location const& loc)
 {
-    io.map("path", loc.Path);
-    io.map("file", loc.Filename);
+    SourceFile const file = loc.file();
+    io.map("path", file.Path);
+    io.map("file", file.Filename);
     io.map("line", loc.LineNumber);
-    io.map("kind", loc.Kind);
+    io.map("kind", file.Kind);
     io.map("documented", loc.Documented);
 }
 
@@ -68,7 +217,7 @@ tag_invoke(
     }
     if (!I.Loc.empty())
     {
-        io.map("decl", dom::LazyArray(I.Loc));
+        io.defer("decl", [&]{ return dom::LazyArray(I.Loc); });
     }
 }
 
@@ -119,11 +119,11 @@ tag_invoke(
     dom::LazyObjectMapTag,
     IO& io,
     TArg const& I,
-    DomCorpus const*)
+    DomCorpus const* domCorpus)
 {
     io.map("kind", toString(I.Kind));
     io.map("is-pack", I.IsPackExpansion);
-    visit(I, [&io]<typename T>(const T& t) {
+    visit(I, [&io, domCorpus]<typename T>(const T& t) {
         if constexpr(T::isType())
         {
             io.map("type", t.Type);
@@ -134,7 +134,7 @@ tag_invoke(
         }
         if constexpr(T::isTemplate())
         {
-            io.map("name", t.Name);
+            io.defer("name", [&]{ return domCorpus->intern(t.Name); });
             io.map("template", t.Template);
         }
     });
@@ -160,7 +160,7 @@ tag_invoke(
     DomCorpus const* domCorpus)
 {
     io.map("kind", toString(I.Kind));
-    io.map("name", dom::stringOrNull(I.Name));
+    io.defer("name", [&]{ return dom::stringOrNull(I.Name); });
     io.map("is-pack", I.IsParameterPack);
     visit(I, [domCorpus, &io]<typename T>(const T& t) {
         if(t.Default)
@@ -181,7 +181,7 @@ tag_invoke(
         }
         if constexpr(T::isTemplate())
         {
-            io.map("params", dom::LazyArray(t.Params, domCorpus));
+            io.defer("params", [&]{ return dom::LazyArray(t.Params, domCorpus); });
         }
     });
 }
@@ -208,9 +208,9 @@ tag_invoke(
         return toString(I.specializationKind());
     });
     io.map("primary", I.Primary);
-    io.map("params", dom::LazyArray(I.Params, domCorpus));
-    io.map("args", dom::LazyArray(I.Args, domCorpus));
-    io.map("requires", dom::stringOrNull(I.Requires.Written));
+    io.defer("params", [&]{ return dom::LazyArray(I.Params, domCorpus); });
+    io.defer("args", [&]{ return dom::LazyArray(I.Args, domCorpus); });
+    io.defer("requires", [&]{ return dom::stringOrNull(I.Requires.Written); });
 }
 
 void
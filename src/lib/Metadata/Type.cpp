@@ -360,7 +360,7 @@ tag_invoke(
         if constexpr(T::isFunction())
         {
             io.map("return-type", t.ReturnType);
-            io.map("param-types", dom::LazyArray(t.ParamTypes, domCorpus));
+            io.defer("param-types", [&]{ return dom::LazyArray(t.ParamTypes, domCorpus); });
             io.map("exception-spec", t.ExceptionSpec);
             io.map("ref-qualifier", t.RefQualifier);
             io.map("is-variadic", t.IsVariadic);
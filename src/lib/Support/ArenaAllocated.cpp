@@ -0,0 +1,161 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include <mrdocs/Support/ArenaAllocated.hpp>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+constexpr std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+constexpr std::size_t maxSize = 1024;
+constexpr std::size_t blockSize = 256 * 1024;
+
+// The number of references to an arena taken
+// at once by the thread which allocates from it
+constexpr std::size_t creditCount = 1024;
+
+// Stored before each object, so the object
+// is returned to the arena it came from
+struct alignas(alignment) Header
+{
+    Arena* arena;
+};
+
+static_assert(sizeof(Header) == alignment);
+
+std::size_t
+roundUp(std::size_t size) noexcept
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+// The arena of the active scope of the thread
+thread_local Arena* currentArena = nullptr;
+
+} // (anon)
+
+// The blocks of a scope, which are released
+// when the scope ended and all of its objects
+// were destroyed
+class Arena
+{
+    // One reference for the scope, and one
+    // for each object or unused credit
+    std::atomic<std::size_t> refs_{1};
+
+    // The references taken for objects which were
+    // not allocated yet, so allocating does not
+    // modify the count shared with other threads
+    std::size_t credits_ = 0;
+
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* pos_ = nullptr;
+    std::size_t avail_ = 0;
+
+public:
+    // Only called by the thread of the scope
+    void*
+    allocate(std::size_t n)
+    {
+        if (credits_ == 0)
+        {
+            refs_.fetch_add(creditCount, std::memory_order_relaxed);
+            credits_ = creditCount;
+        }
+        if (n > avail_)
+        {
+            blocks_.emplace_back(new char[blockSize]);
+            pos_ = blocks_.back().get();
+            avail_ = blockSize;
+        }
+        --credits_;
+        avail_ -= n;
+        return std::exchange(pos_, pos_ + n);
+    }
+
+    // Release the references of the
+    // scope and its unused credits
+    void
+    close() noexcept
+    {
+        release(credits_ + 1);
+    }
+
+    void
+    release(std::size_t n = 1) noexcept
+    {
+        if (refs_.fetch_sub(n, std::memory_order_acq_rel) == n)
+        {
+            delete this;
+        }
+    }
+};
+
+void*
+ArenaAllocated::
+operator new(std::size_t size)
+{
+    std::size_t const n = sizeof(Header) + size;
+    Arena* arena = currentArena;
+    void* p;
+    if (arena && size <= maxSize)
+    {
+        p = arena->allocate(roundUp(n));
+    }
+    else
+    {
+        p = ::operator new(n);
+        arena = nullptr;
+    }
+    return ::new(p) Header{arena} + 1;
+}
+
+void
+ArenaAllocated::
+operator delete(
+    void* p,
+    std::size_t size) noexcept
+{
+    if (!p)
+    {
+        return;
+    }
+    Header* const h = static_cast<Header*>(p) - 1;
+    if (h->arena)
+    {
+        h->arena->release();
+        return;
+    }
+    ::operator delete(h, sizeof(Header) + size);
+}
+
+ArenaScope::
+ArenaScope()
+    : arena_(new Arena)
+    , prev_(std::exchange(currentArena, arena_))
+{
+}
+
+ArenaScope::
+~ArenaScope()
+{
+    currentArena = prev_;
+    arena_->close();
+}
+
+} // mrdocs
+} // clang
@@ -0,0 +1,305 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/CharSet.hpp"
+#include <mrdocs/Support/Assert.hpp>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64) || \
+    defined(__i386__) || defined(_M_IX86)
+#   define MRDOCS_CHARSET_X86
+#   include <immintrin.h>
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#   endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define MRDOCS_CHARSET_NEON
+#   include <arm_neon.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define MRDOCS_TARGET(features) __attribute__((target(features)))
+#else
+#   define MRDOCS_TARGET(features)
+#endif
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+using FindFn = std::size_t (*)(
+    char const* data,
+    std::size_t size,
+    bool const* table,
+    std::uint8_t const* lo,
+    std::uint8_t const* hi) noexcept;
+
+std::size_t
+findScalar(
+    char const* data,
+    std::size_t const size,
+    bool const* table,
+    std::uint8_t const*,
+    std::uint8_t const*) noexcept
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (table[static_cast<unsigned char>(data[i])])
+        {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+#if defined(MRDOCS_CHARSET_X86)
+
+MRDOCS_TARGET("ssse3")
+std::size_t
+findSSSE3(
+    char const* data,
+    std::size_t const size,
+    bool const* table,
+    std::uint8_t const* lo,
+    std::uint8_t const* hi) noexcept
+{
+    __m128i const loTable = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(lo));
+    __m128i const hiTable = _mm_loadu_si128(
+        reinterpret_cast<__m128i const*>(hi));
+    __m128i const nibble = _mm_set1_epi8(0x0F);
+    __m128i const zero = _mm_setzero_si128();
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i const v = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(data + i));
+        __m128i const l = _mm_shuffle_epi8(
+            loTable, _mm_and_si128(v, nibble));
+        __m128i const h = _mm_shuffle_epi8(
+            hiTable, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+        __m128i const found = _mm_cmpeq_epi8(_mm_and_si128(l, h), zero);
+        auto const mask = static_cast<unsigned>(
+            _mm_movemask_epi8(found)) ^ 0xFFFFu;
+        if (mask != 0)
+        {
+            return i + std::countr_zero(mask);
+        }
+    }
+    std::size_t const pos = findScalar(data + i, size - i, table, lo, hi);
+    return pos == std::string_view::npos ? pos : i + pos;
+}
+
+MRDOCS_TARGET("avx2")
+std::size_t
+findAVX2(
+    char const* data,
+    std::size_t const size,
+    bool const* table,
+    std::uint8_t const* lo,
+    std::uint8_t const* hi) noexcept
+{
+    // The shuffle works within each 128-bit lane,
+    // so the tables are repeated in both lanes
+    __m256i const loTable = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(lo)));
+    __m256i const hiTable = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<__m128i const*>(hi)));
+    __m256i const nibble = _mm256_set1_epi8(0x0F);
+    __m256i const zero = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i const v = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(data + i));
+        __m256i const l = _mm256_shuffle_epi8(
+            loTable, _mm256_and_si256(v, nibble));
+        __m256i const h = _mm256_shuffle_epi8(
+            hiTable, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+        __m256i const found = _mm256_cmpeq_epi8(_mm256_and_si256(l, h), zero);
+        auto const mask = ~static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(found));
+        if (mask != 0)
+        {
+            return i + std::countr_zero(mask);
+        }
+    }
+    std::size_t const pos = findSSSE3(data + i, size - i, table, lo, hi);
+    return pos == std::string_view::npos ? pos : i + pos;
+}
+
+struct CpuFeatures
+{
+    bool ssse3 = false;
+    bool avx2 = false;
+};
+
+CpuFeatures
+detectFeatures() noexcept
+{
+    CpuFeatures features;
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    features.ssse3 = (info[2] & (1 << 9)) != 0;
+    bool const osxsave = (info[2] & (1 << 27)) != 0;
+    if (osxsave && (_xgetbv(0) & 6) == 6)
+    {
+        __cpuidex(info, 7, 0);
+        features.avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    features.ssse3 = __builtin_cpu_supports("ssse3");
+    features.avx2 = __builtin_cpu_supports("avx2");
+#endif
+    return features;
+}
+
+FindFn
+getFind(CharSet::Kernel const kernel) noexcept
+{
+    static CpuFeatures const features = detectFeatures();
+    switch (kernel)
+    {
+    case CharSet::Kernel::Scalar:
+        return &findScalar;
+    case CharSet::Kernel::SSSE3:
+        return features.ssse3 ? &findSSSE3 : nullptr;
+    case CharSet::Kernel::AVX2:
+        return features.avx2 ? &findAVX2 : nullptr;
+    default:
+        return nullptr;
+    }
+}
+
+#elif defined(MRDOCS_CHARSET_NEON)
+
+std::size_t
+findNEON(
+    char const* data,
+    std::size_t const size,
+    bool const* table,
+    std::uint8_t const* lo,
+    std::uint8_t const* hi) noexcept
+{
+    uint8x16_t const loTable = vld1q_u8(lo);
+    uint8x16_t const hiTable = vld1q_u8(hi);
+    uint8x16_t const nibble = vdupq_n_u8(0x0F);
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        uint8x16_t const v = vld1q_u8(
+            reinterpret_cast<std::uint8_t const*>(data + i));
+        uint8x16_t const l = vqtbl1q_u8(loTable, vandq_u8(v, nibble));
+        uint8x16_t const h = vqtbl1q_u8(hiTable, vshrq_n_u8(v, 4));
+        if (vmaxvq_u8(vandq_u8(l, h)) != 0)
+        {
+            // The block has a match, which
+            // the table locates
+            return i + findScalar(data + i, 16, table, lo, hi);
+        }
+    }
+    std::size_t const pos = findScalar(data + i, size - i, table, lo, hi);
+    return pos == std::string_view::npos ? pos : i + pos;
+}
+
+FindFn
+getFind(CharSet::Kernel const kernel) noexcept
+{
+    switch (kernel)
+    {
+    case CharSet::Kernel::Scalar:
+        return &findScalar;
+    case CharSet::Kernel::NEON:
+        return &findNEON;
+    default:
+        return nullptr;
+    }
+}
+
+#else
+
+FindFn
+getFind(CharSet::Kernel const kernel) noexcept
+{
+    if (kernel == CharSet::Kernel::Scalar)
+    {
+        return &findScalar;
+    }
+    return nullptr;
+}
+
+#endif
+
+// Return the fastest kernel the CPU supports
+FindFn
+selectFind() noexcept
+{
+    for (CharSet::Kernel const kernel : {
+        CharSet::Kernel::AVX2,
+        CharSet::Kernel::SSSE3,
+        CharSet::Kernel::NEON })
+    {
+        if (FindFn const fn = getFind(kernel))
+        {
+            return fn;
+        }
+    }
+    return &findScalar;
+}
+
+} // (anon)
+
+bool
+CharSet::
+isSupported(Kernel const kernel) noexcept
+{
+    return getFind(kernel) != nullptr;
+}
+
+std::size_t
+CharSet::
+find(std::string_view const str) const noexcept
+{
+    if (!ascii_)
+    {
+        return findScalar(
+            str.data(), str.size(),
+            table_.data(), lo_.data(), hi_.data());
+    }
+    static FindFn const findImpl = selectFind();
+    return findImpl(
+        str.data(), str.size(),
+        table_.data(), lo_.data(), hi_.data());
+}
+
+std::size_t
+CharSet::
+find(
+    std::string_view const str,
+    Kernel const kernel) const noexcept
+{
+    FindFn const findImpl = getFind(kernel);
+    MRDOCS_ASSERT(findImpl);
+    if (!ascii_)
+    {
+        return findScalar(
+            str.data(), str.size(),
+            table_.data(), lo_.data(), hi_.data());
+    }
+    return findImpl(
+        str.data(), str.size(),
+        table_.data(), lo_.data(), hi_.data());
+}
+
+} // mrdocs
+} // clang
@@ -0,0 +1,193 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_SUPPORT_CHARSET_HPP
+#define MRDOCS_LIB_SUPPORT_CHARSET_HPP
+
+#include <mrdocs/Platform.hpp>
+#include <mrdocs/Support/Handlebars.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace clang {
+namespace mrdocs {
+
+/** A set of characters which can be searched for.
+
+    Searching a string for the characters of the set
+    processes 16 or 32 bytes at a time when the CPU
+    supports SSSE3, AVX2, or NEON, and one byte at a
+    time otherwise.
+
+    The vectorized search classifies each byte by its
+    low and high nibbles. A byte is in the set if the
+    bits for its low nibble and for its high nibble
+    intersect, which is exact for ASCII characters.
+    Sets with other characters are always searched
+    one byte at a time.
+*/
+class CharSet
+{
+    std::array<bool, 256> table_{};
+    std::array<std::uint8_t, 16> lo_{};
+    std::array<std::uint8_t, 16> hi_{};
+    bool ascii_ = true;
+
+public:
+    /** An implementation of the search.
+    */
+    enum class Kernel
+    {
+        /// One byte at a time
+        Scalar,
+        /// 16 bytes at a time, on x86
+        SSSE3,
+        /// 32 bytes at a time, on x86
+        AVX2,
+        /// 16 bytes at a time, on ARM
+        NEON
+    };
+
+    /** Return true if a kernel can be used.
+
+        A kernel can be used if it was compiled
+        for the target and the CPU supports it.
+    */
+    MRDOCS_DECL
+    static
+    bool
+    isSupported(Kernel kernel) noexcept;
+
+    /** Constructor.
+
+        @param chars The characters in the set.
+    */
+    constexpr
+    explicit
+    CharSet(std::string_view chars) noexcept
+    {
+        for (std::size_t h = 0; h < 8; ++h)
+        {
+            hi_[h] = static_cast<std::uint8_t>(1u << h);
+        }
+        for (char const c : chars)
+        {
+            auto const u = static_cast<unsigned char>(c);
+            table_[u] = true;
+            if (u >= 0x80)
+            {
+                ascii_ = false;
+                continue;
+            }
+            lo_[u & 0x0F] |= static_cast<std::uint8_t>(1u << (u >> 4));
+        }
+    }
+
+    /** Return true if the character is in the set.
+    */
+    constexpr
+    bool
+    contains(char const c) const noexcept
+    {
+        return table_[static_cast<unsigned char>(c)];
+    }
+
+    /** Return the position of the first character in the set.
+
+        @return The position, or `std::string_view::npos`
+        if the string has no characters in the set.
+
+        @param str The string to search.
+    */
+    MRDOCS_DECL
+    std::size_t
+    find(std::string_view str) const noexcept;
+
+    /** Return the position of the first character in the set.
+
+        This function searches with a specific kernel
+        rather than the fastest kernel the CPU supports.
+        Sets with characters which are not ASCII are
+        always searched one byte at a time.
+
+        @return The position, or `std::string_view::npos`
+        if the string has no characters in the set.
+
+        @param str The string to search.
+        @param kernel The kernel, which must be supported.
+    */
+    MRDOCS_DECL
+    std::size_t
+    find(
+        std::string_view str,
+        Kernel kernel) const noexcept;
+};
+
+/** Write a string, replacing the characters in a set.
+
+    The runs of characters which are not in the set
+    are written with a single call to the output.
+
+    @param out The output.
+    @param str The string to write.
+    @param special The characters to replace.
+    @param replace A function which writes the
+    replacement of a character in the set.
+*/
+template <class Replace>
+void
+replaceChars(
+    OutputRef& out,
+    std::string_view str,
+    CharSet const& special,
+    Replace const& replace)
+{
+    // The output only indents the lines which start
+    // within a single write, so the lines of a run are
+    // written separately, as if each character of the
+    // run were written by itself.
+    auto const writeRun = [&](std::string_view run)
+    {
+        if (out.getIndent() != 0)
+        {
+            std::size_t nl;
+            while ((nl = run.find('\n')) != std::string_view::npos &&
+                   nl + 1 < run.size())
+            {
+                out << run.substr(0, nl + 1);
+                run.remove_prefix(nl + 1);
+            }
+        }
+        if (!run.empty())
+        {
+            out << run;
+        }
+    };
+
+    while (!str.empty())
+    {
+        std::size_t const pos = special.find(str);
+        if (pos == std::string_view::npos)
+        {
+            writeRun(str);
+            return;
+        }
+        writeRun(str.substr(0, pos));
+        replace(out, str[pos]);
+        str.remove_prefix(pos + 1);
+    }
+}
+
+} // mrdocs
+} // clang
+
+#endif
@@ -12,6 +12,7 @@
 #include "lib/AST/ParseJavadoc.hpp"
 #include "lib/Support/Path.hpp"
 #include "lib/Support/Chrono.hpp"
+#include "lib/Support/Trace.hpp"
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Generator.hpp>
 #include <llvm/ADT/SmallString.h>
@@ -52,7 +53,10 @@ build(Corpus const& corpus) const
         files::makeAbsolute(
             corpus.config->output,
             corpus.config->configDir()));
-    MRDOCS_TRY(build(absOutput, corpus));
+    {
+        trace::Span span("Generate", this->displayName());
+        MRDOCS_TRY(build(absOutput, corpus));
+    }
     report::info(
         "Generated {} documentation in {}",
         this->displayName(),
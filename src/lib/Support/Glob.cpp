@@ -8,6 +8,7 @@
 // Official repository: https://github.com/cppalliance/mrdocs
 //
 
+#include <algorithm>
 #include <ranges>
 #include <llvm/ADT/BitVector.h>
 #include <llvm/ADT/SmallVector.h>
@@ -623,5 +624,200 @@ pattern() const
     return impl_->pattern;
 }
 
+namespace {
+
+/*  Match the rest of a string against the subglobs of a pattern.
+
+    The string must start with the prefix of the pattern.
+ */
+bool
+matchSubGlobs(
+    llvm::SmallVector<SubGlobPattern, 1> const& subGlobs,
+    std::string_view const suffix,
+    char const delimiter,
+    bool const partial)
+{
+    if (subGlobs.empty())
+    {
+        return suffix.empty();
+    }
+    for (auto& subGlob: subGlobs)
+    {
+        auto const m = subGlob.match(suffix, delimiter);
+        if (m == SubGlobPattern::MatchType::FULL ||
+            (partial && m == SubGlobPattern::MatchType::PARTIAL))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // (anon)
+
+struct GlobPatternSet::Impl {
+    struct Node {
+        // The children of the node, sorted by character
+        std::vector<std::pair<char, std::uint32_t>> children;
+        // The patterns whose prefix ends at this node
+        std::vector<std::uint32_t> patterns;
+    };
+
+    std::vector<GlobPattern> globs;
+    std::vector<Node> nodes;
+
+    std::size_t
+    prefixSize(std::uint32_t const i) const
+    {
+        auto const& impl = globs[i].impl_;
+        return impl ? impl->prefix.size() : 0;
+    }
+
+    bool
+    matchSuffix(
+        std::uint32_t const i,
+        std::string_view const str,
+        char const delimiter,
+        bool const partial) const
+    {
+        auto const& impl = globs[i].impl_;
+        if (!impl)
+        {
+            return str.empty();
+        }
+        return matchSubGlobs(
+            impl->subGlobs,
+            str.substr(impl->prefix.size()),
+            delimiter,
+            partial);
+    }
+};
+
+GlobPatternSet::
+GlobPatternSet(std::vector<GlobPattern> patterns)
+{
+    auto impl = std::make_shared<Impl>();
+    impl->globs = std::move(patterns);
+    impl->nodes.emplace_back();
+    for (std::uint32_t i = 0; i < impl->globs.size(); ++i)
+    {
+        auto const& glob = impl->globs[i].impl_;
+        std::string_view const prefix =
+            glob ? std::string_view(glob->prefix) : std::string_view();
+        std::uint32_t node = 0;
+        for (char const c: prefix)
+        {
+            auto& children = impl->nodes[node].children;
+            auto it = std::ranges::lower_bound(
+                children, c, {}, &std::pair<char, std::uint32_t>::first);
+            if (it == children.end() || it->first != c)
+            {
+                auto const child = static_cast<std::uint32_t>(impl->nodes.size());
+                children.emplace(it, c, child);
+                impl->nodes.emplace_back();
+                node = child;
+            }
+            else
+            {
+                node = it->second;
+            }
+        }
+        impl->nodes[node].patterns.push_back(i);
+    }
+    impl_ = std::move(impl);
+}
+
+bool
+GlobPatternSet::
+empty() const noexcept
+{
+    return !impl_ || impl_->globs.empty();
+}
+
+GlobPatternSet::State
+GlobPatternSet::
+start() const
+{
+    State state;
+    if (impl_)
+    {
+        state.candidates_ = impl_->nodes.front().patterns;
+    }
+    return state;
+}
+
+void
+GlobPatternSet::
+advance(State& state, std::string_view const str) const
+{
+    MRDOCS_ASSERT(str.size() >= state.size_);
+    if (!impl_)
+    {
+        state.size_ = str.size();
+        return;
+    }
+    for (std::size_t i = state.size_; state.inTrie_ && i < str.size(); ++i)
+    {
+        auto const& children = impl_->nodes[state.node_].children;
+        auto const it = std::ranges::lower_bound(
+            children, str[i], {}, &std::pair<char, std::uint32_t>::first);
+        if (it == children.end() || it->first != str[i])
+        {
+            state.inTrie_ = false;
+            break;
+        }
+        state.node_ = it->second;
+        auto const& patterns = impl_->nodes[state.node_].patterns;
+        state.candidates_.insert(
+            state.candidates_.end(), patterns.begin(), patterns.end());
+    }
+    state.size_ = str.size();
+}
+
+bool
+GlobPatternSet::
+match(
+    State const& state,
+    std::string_view const str,
+    char const delimiter) const
+{
+    MRDOCS_ASSERT(state.size_ == str.size());
+    if (!impl_)
+    {
+        return false;
+    }
+    return std::ranges::any_of(state.candidates_,
+        [&](std::uint32_t const i)
+        {
+            return impl_->matchSuffix(i, str, delimiter, false);
+        });
+}
+
+bool
+GlobPatternSet::
+matchPatternPrefix(
+    State const& state,
+    std::string_view const prefix,
+    char const delimiter) const
+{
+    MRDOCS_ASSERT(state.size_ == prefix.size());
+    if (!impl_)
+    {
+        return false;
+    }
+    // The string is a proper prefix of the
+    // literal prefix of another pattern
+    if (state.inTrie_ &&
+        !impl_->nodes[state.node_].children.empty())
+    {
+        return true;
+    }
+    return std::ranges::any_of(state.candidates_,
+        [&](std::uint32_t const i)
+        {
+            return impl_->matchSuffix(i, prefix, delimiter, true);
+        });
+}
+
 } // clang::mrdocs
 
@@ -8,6 +8,8 @@
 // Official repository: https://github.com/cppalliance/mrdocs
 //
 
+#include "lib/Support/CharSet.hpp"
+#include "lib/Support/Trace.hpp"
 #include <mrdocs/Support/Handlebars.hpp>
 #include <mrdocs/Support/Path.hpp>
 #include <fmt/format.h>
@@ -19,6 +21,7 @@
 #include <algorithm>
 #include <unordered_set>
 #include <utility>
+#include <optional>
 
 namespace clang {
 namespace mrdocs {
@@ -303,28 +306,21 @@ HTMLEscape(
     std::string_view str)
 {
     // https://github.com/handlebars-lang/handlebars.js/blob/master/lib/handlebars/utils.js
-    static constexpr std::pair<char, std::string_view>
-        escapeMap[] = {
-            {'&', "&amp;"},
-            {'<', "&lt;"},
-            {'>', "&gt;"},
-            {'"', "&quot;"},
-            {'\'', "&#x27;"},
-            {'`', "&#x60;"},
-            {'=', "&#x3D;"}
-        };
-    static constexpr auto badChars = std::views::keys(escapeMap);
-    for (auto c : str)
+    static constexpr CharSet badChars("&<>\"'`=");
+    replaceChars(out, str, badChars, [](OutputRef& out, char const c)
     {
-        if (auto it = std::ranges::find(badChars, c); it != badChars.end())
-        {
-            out << it.base()->second;
-        }
-        else
+        switch (c)
         {
-            out << c;
+            case '&': out << "&amp;"; break;
+            case '<': out << "&lt;"; break;
+            case '>': out << "&gt;"; break;
+            case '"': out << "&quot;"; break;
+            case '\'': out << "&#x27;"; break;
+            case '`': out << "&#x60;"; break;
+            case '=': out << "&#x3D;"; break;
+            default: MRDOCS_UNREACHABLE();
         }
-    }
+    });
 }
 
 std::string
@@ -501,6 +497,15 @@ namespace detail {
          */
         std::string_view templateText;
 
+        /* The compiled template of rootTemplateText.
+
+           This is null when the template being rendered
+           was not compiled, such as inline partials and
+           templates rendered directly from their text.
+
+         */
+        CompiledTemplate const* compiled = nullptr;
+
         /* A vector of inline partials view maps.
 
            This vector is used to store maps of inline partials
@@ -1467,6 +1472,174 @@ parseTag(
     return t;
 }
 
+namespace detail {
+    /* The tags parsed from a template text.
+
+       The tags are found by scanning the whole text
+       once, in the same way they are found while
+       rendering it.
+
+     */
+    struct CompiledTemplate
+    {
+        struct CompiledTag
+        {
+            // Offset of the tag, including escape characters
+            std::size_t begin = 0;
+
+            // Offset of the opening "{{"
+            std::size_t open = 0;
+
+            // Offset after the closing tag
+            std::size_t end = 0;
+
+            // Whether the tag is escaped by a backslash
+            bool escaped = false;
+
+            // The parsed tag, if it is not escaped
+            Handlebars::Tag tag;
+        };
+
+        // The template text the tags refer to
+        std::string text;
+
+        // The tags in the order they appear in the text
+        std::vector<CompiledTag> tags;
+
+        // Whether the text after the last tag has no tags
+        bool complete = true;
+    };
+}
+
+HandlebarsTemplate::
+HandlebarsTemplate(
+    std::shared_ptr<detail::CompiledTemplate const> impl) noexcept
+    : impl_(std::move(impl))
+{
+}
+
+std::string_view
+HandlebarsTemplate::
+text() const noexcept
+{
+    if (!impl_)
+    {
+        return {};
+    }
+    return impl_->text;
+}
+
+HandlebarsTemplate
+Handlebars::
+compile(std::string_view templateText)
+{
+    auto impl = std::make_shared<detail::CompiledTemplate>();
+    impl->text = templateText;
+    std::string_view const text = impl->text;
+    std::string_view rest = text;
+    std::string_view tagStr;
+    while (findTag(tagStr, rest))
+    {
+        detail::CompiledTemplate::CompiledTag t;
+        t.begin = tagStr.data() - text.data();
+        t.open = t.begin + tagStr.find('{');
+        t.end = t.begin + tagStr.size();
+        t.escaped = t.open != t.begin;
+        if (!t.escaped)
+        {
+            t.tag = parseTag(tagStr, text);
+        }
+        impl->tags.push_back(t);
+        rest = text.substr(t.end);
+    }
+    impl->complete =
+        rest.size() < 4 ||
+        rest.find("{{") == std::string_view::npos;
+    return HandlebarsTemplate(std::move(impl));
+}
+
+// Find the next handlebars tag with the compiled tags
+// of the template being rendered.
+// Returns std::nullopt if the compiled tags cannot be
+// used, in which case the tag should be found with
+// findTag. Otherwise, returns the same result as findTag
+// and sets compiled to the parsed tag.
+std::optional<bool>
+findCompiledTag(
+    std::string_view& tag,
+    Handlebars::Tag const*& compiled,
+    std::string_view templateText,
+    detail::RenderState const& state)
+{
+    detail::CompiledTemplate const* program = state.compiled;
+    if (!program ||
+        state.rootTemplateText.data() != program->text.data() ||
+        state.rootTemplateText.size() != program->text.size())
+    {
+        return std::nullopt;
+    }
+    std::string_view const text = program->text;
+    if (templateText.data() < text.data() ||
+        templateText.data() + templateText.size() > text.data() + text.size())
+    {
+        return std::nullopt;
+    }
+    if (templateText.size() < 4)
+    {
+        return false;
+    }
+
+    // Find the first tag opening in the template text
+    std::size_t const first = templateText.data() - text.data();
+    std::size_t const last = first + templateText.size();
+    auto const& tags = program->tags;
+    auto it = std::ranges::lower_bound(
+        tags, first, std::less<>{},
+        &detail::CompiledTemplate::CompiledTag::open);
+    if (it != tags.begin() && std::prev(it)->end > first)
+    {
+        // The template text starts inside a tag
+        return std::nullopt;
+    }
+    if (it == tags.end())
+    {
+        if (program->complete)
+        {
+            return false;
+        }
+        return std::nullopt;
+    }
+    if (it->open + 2 > last)
+    {
+        return false;
+    }
+    if (it->escaped || it->end > last)
+    {
+        return std::nullopt;
+    }
+    tag = text.substr(it->begin, it->end - it->begin);
+    compiled = &it->tag;
+    return true;
+}
+
+// Find the next handlebars tag, using the compiled tags
+// when possible.
+// If compiled is set, it points to the parsed tag.
+bool
+findTag(
+    std::string_view& tag,
+    Handlebars::Tag const*& compiled,
+    std::string_view templateText,
+    detail::RenderState const& state)
+{
+    compiled = nullptr;
+    if (auto found = findCompiledTag(tag, compiled, templateText, state))
+    {
+        return *found;
+    }
+    return findTag(tag, templateText);
+}
+
 Expected<void, HandlebarsError>
 Handlebars::
 try_render_to(
@@ -1487,6 +1660,27 @@ try_render_to(
     return try_render_to_impl(out, context, options, state);
 }
 
+Expected<void, HandlebarsError>
+Handlebars::
+try_render_to(
+    OutputRef& out,
+    HandlebarsTemplate const& tmpl,
+    dom::Value const& context,
+    HandlebarsOptions const& options) const
+{
+    detail::RenderState state;
+    state.rootTemplateText = tmpl.text();
+    state.templateText = tmpl.text();
+    state.compiled = tmpl.impl_.get();
+    if (options.data.isObject()) {
+        state.context = options.data.getObject();
+    }
+    state.inlinePartials.emplace_back();
+    state.rootContext = context;
+    state.contextStack.emplace_back(state.context);
+    return try_render_to_impl(out, context, options, state);
+}
+
 Expected<void, HandlebarsError>
 Handlebars::
 try_render_to_impl(
@@ -1501,7 +1695,8 @@ try_render_to_impl(
         // Find next tag
         // ==============================================================
         std::string_view tagStr;
-        if (!findTag(tagStr, state.templateText))
+        Tag const* compiled;
+        if (!findTag(tagStr, compiled, state.templateText, state))
         {
             out << state.templateText;
             break;
@@ -1511,7 +1706,7 @@ try_render_to_impl(
             tagStr.remove_prefix(2);
         }
         std::size_t tagStartPos = tagStr.data() - state.templateText.data();
-        Tag tag = parseTag(tagStr, state.rootTemplateText);
+        Tag tag = compiled ? *compiled : parseTag(tagStr, state.rootTemplateText);
 
         // ==============================================================
         // Render template text before tag
@@ -2103,9 +2298,12 @@ auto
 Handlebars::
 getPartial(
     std::string_view name,
-    detail::RenderState const& state) const
+    detail::RenderState const& state,
+    detail::CompiledTemplate const*& compiled) const
     -> std::pair<std::string_view, bool>
 {
+    compiled = nullptr;
+
     // Inline partials
     auto blockPartials = std::ranges::views::reverse(state.inlinePartials);
     for (auto blockInlinePartials: blockPartials)
@@ -2121,7 +2319,8 @@ getPartial(
     auto it = this->partials_.find(name);
     if (it != this->partials_.end())
     {
-        return {it->second, true};
+        compiled = it->second.impl_.get();
+        return {it->second.text(), true};
     }
 
     // Partial block
@@ -2181,12 +2380,14 @@ parseBlock(
         // Find next tag
         // ==============================================================
         std::string_view tagStr;
-        if (!findTag(tagStr, templateText))
+        Handlebars::Tag const* compiled;
+        if (!findTag(tagStr, compiled, templateText, state))
         {
             break;
         }
 
-        Handlebars::Tag curTag = parseTag(tagStr, state.rootTemplateText);
+        Handlebars::Tag curTag =
+            compiled ? *compiled : parseTag(tagStr, state.rootTemplateText);
 
         // move template after the tag
         auto tag_pos = curTag.buffer.data() - templateText.data();
@@ -2787,7 +2988,8 @@ renderPartial(
     // ==============================================================
     // Find registered partial content
     // ==============================================================
-    auto [partial_content, found] = getPartial(partialName, state);
+    detail::CompiledTemplate const* compiled;
+    auto [partial_content, found] = getPartial(partialName, state, compiled);
     if (!found)
     {
         if (tag.type2 == '#')
@@ -2957,6 +3159,8 @@ renderPartial(
     // ==========================================
     std::string_view rootTemplateText = state.rootTemplateText;
     state.rootTemplateText = partial_content;
+    detail::CompiledTemplate const* rootCompiled = state.compiled;
+    state.compiled = compiled;
     std::string_view templateText = state.templateText;
     state.templateText = partial_content;
     bool const isPartialBlock = partialName == "@partial-block";
@@ -2971,7 +3175,13 @@ renderPartial(
     // ==========================================
     // Render partial
     // ==========================================
-    MRDOCS_TRY(this->try_render_to_impl(out, partialCtx, opt, state));
+    {
+        // Partials are rendered many times per page,
+        // so only the slow ones are recorded
+        trace::Span span(
+            "Partial", partialName, std::chrono::microseconds(100));
+        MRDOCS_TRY(this->try_render_to_impl(out, partialCtx, opt, state));
+    }
 
     // ==========================================
     // Restore state
@@ -2985,6 +3195,7 @@ renderPartial(
     state.partialBlockLevel += isPartialBlock;
     state.templateText = templateText;
     state.rootTemplateText = rootTemplateText;
+    state.compiled = rootCompiled;
     if (opt.trackIds && partialCtxChanged)
     {
         state.context.set("contextPath", prevContextPath);
@@ -3487,7 +3698,7 @@ registerPartial(
     auto it = partials_.find(name);
     if (it != partials_.end())
         partials_.erase(it);
-    partials_.emplace(std::string(name), std::string(text));
+    partials_.emplace(std::string(name), compile(text));
 }
 
 void
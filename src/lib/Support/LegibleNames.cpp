@@ -16,12 +16,15 @@
 #include <mrdocs/Corpus.hpp>
 #include <mrdocs/Metadata.hpp>
 #include <mrdocs/Platform.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
 #include <mrdocs/Support/TypeTraits.hpp>
 #include <fmt/format.h>
 #include <algorithm>
 #include <ranges>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace clang {
 namespace mrdocs {
@@ -43,6 +46,10 @@ class LegibleNames::Impl
         std::uint8_t disambig_chars;
         // SymbolID converted to a string
         std::string id_str;
+        // legible name with disambiguation characters
+        std::string legible = {};
+        // qualified legible names delimited by '-' and '/'
+        std::string qualified[2] = {};
     };
 
     std::unordered_map<SymbolID, LegibleNameInfo> map_;
@@ -325,6 +332,8 @@ public:
         // set the number of disambiguation characters
         // used for the global namespace to zero
         map_.at(global.id).disambig_chars = 0;
+        disambiguation_map_.clear();
+        buildLegibleNames();
     }
 
     template<typename InfoTy>
@@ -345,19 +354,35 @@ public:
             });
     }
 
-    void
+    std::string_view
     getLegibleUnqualified(
-        std::string& result,
-        const SymbolID& id)
+        const SymbolID& id) const
+    {
+        auto const it = map_.find(id);
+        MRDOCS_ASSERT(it != map_.end());
+        return it->second.legible;
+    }
+
+    std::string_view
+    getLegibleQualified(
+        const SymbolID& id,
+        char const delim) const
     {
-        MRDOCS_ASSERT(corpus_.exists(id));
+        MRDOCS_ASSERT(delim == '-' || delim == '/');
         auto const it = map_.find(id);
         MRDOCS_ASSERT(it != map_.end());
-        auto& [unqualified, n_disambig, id_str] = it->second;
+        return it->second.qualified[delim == '/'];
+    }
+
+private:
+    void
+    buildLegibleUnqualified(
+        LegibleNameInfo& info)
+    {
+        auto& [unqualified, n_disambig, id_str, result, qualified] = info;
         result.reserve(
-            result.size() +
             unqualified.size() +
-            n_disambig ? n_disambig + 2 : 0);
+            (n_disambig ? n_disambig + 2 : 0));
         result.append(unqualified);
         if(n_disambig)
         {
@@ -371,23 +396,66 @@ public:
     }
 
     void
-    getLegibleQualified(
-        std::string& result,
-        const SymbolID& id,
-        char const delim)
+    buildLegibleQualified(
+        LegibleNameInfo& info,
+        const SymbolID& id)
     {
-        MRDOCS_ASSERT(corpus_.exists(id));
         auto const& I = corpus_.get(id);
-        for(auto const& parent : getParents(corpus_, I))
+        auto const parents = corpus_.parents(I);
+        char const delims[] = { '-', '/' };
+        for(std::size_t i = 0; i < std::size(delims); ++i)
         {
-            if (!parent || parent == SymbolID::global)
+            std::string& result = info.qualified[i];
+            for(auto const& parent : parents)
             {
-                continue;
+                if (!parent || parent == SymbolID::global)
+                {
+                    continue;
+                }
+                result.append(getLegibleUnqualified(parent));
+                result.push_back(delims[i]);
             }
-            getLegibleUnqualified(result, parent);
-            result.push_back(delim);
+            result.append(info.legible);
+        }
+    }
+
+    // Build the legible names of every symbol once the
+    // disambiguation characters are known. The qualified
+    // names only read the unqualified names of the parents,
+    // so they are built in parallel.
+    void
+    buildLegibleNames()
+    {
+        std::vector<std::pair<SymbolID const, LegibleNameInfo>*> infos;
+        infos.reserve(map_.size());
+        for(auto& entry : map_)
+        {
+            buildLegibleUnqualified(entry.second);
+            infos.push_back(&entry);
+        }
+
+        ThreadPool& threadPool = corpus_.config.threadPool();
+        std::size_t const n = std::min<std::size_t>(
+            infos.size(), threadPool.getThreadCount() * 8);
+        TaskGroup taskGroup(threadPool);
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            taskGroup.async(
+                [this, &infos, i, n]
+                {
+                    std::size_t const first = infos.size() * i / n;
+                    std::size_t const last = infos.size() * (i + 1) / n;
+                    for(std::size_t j = first; j < last; ++j)
+                    {
+                        buildLegibleQualified(
+                            infos[j]->second, infos[j]->first);
+                    }
+                });
+        }
+        if(auto errors = taskGroup.wait(); !errors.empty())
+        {
+            Error(errors).Throw();
         }
-        getLegibleUnqualified(result, id);
     }
 };
 
@@ -399,22 +467,39 @@ LegibleNames(
     bool enabled)
 {
     if(enabled)
+    {
         impl_ = std::make_unique<Impl>(corpus, "index");
+        return;
+    }
+    ids_.reserve(corpus.size());
+    for(Info const& I : corpus)
+        ids_.emplace(I.id, toBase16(I.id));
 }
 
 LegibleNames::
 ~LegibleNames() noexcept = default;
 
-std::string
+std::string_view
+LegibleNames::
+getBase16(
+    SymbolID const& id) const
+{
+    if(auto const it = ids_.find(id); it != ids_.end())
+        return it->second;
+    // The nodes of the map are never moved,
+    // so the views remain valid
+    std::lock_guard<std::mutex> lock(otherIdsMutex_);
+    return otherIds_.try_emplace(id, toBase16(id)).first->second;
+}
+
+std::string_view
 LegibleNames::
 getUnqualified(
     SymbolID const& id) const
 {
     if(! impl_)
-        return toBase16(id);
-    std::string result;
-    impl_->getLegibleUnqualified(result, id);
-    return result;
+        return getBase16(id);
+    return impl_->getLegibleUnqualified(id);
 }
 
 std::string
@@ -428,7 +513,7 @@ getUnqualified(
     return result;
 }
 
-std::string
+std::string_view
 LegibleNames::
 getQualified(
     SymbolID const& id,
@@ -436,11 +521,9 @@ getQualified(
 {
     if (!impl_)
     {
-        return toBase16(id);
+        return getBase16(id);
     }
-    std::string result;
-    impl_->getLegibleQualified(result, id, delim);
-    return result;
+    return impl_->getLegibleQualified(id, delim);
 }
 
 std::string
@@ -454,7 +537,7 @@ getQualified(
     std::string result;
     if(os.Parent != SymbolID::global)
     {
-        impl_->getLegibleQualified(result, os.Parent, delim);
+        result.append(impl_->getLegibleQualified(os.Parent, delim));
         result.push_back(delim);
     }
     // the legible name for an overload set is the unqualified
@@ -13,8 +13,12 @@
 
 #include <mrdocs/Platform.hpp>
 #include <mrdocs/MetadataFwd.hpp>
+#include <mrdocs/Metadata/Symbols.hpp>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 namespace clang {
 namespace mrdocs {
@@ -34,11 +38,25 @@ class LegibleNames
 
     std::unique_ptr<Impl> impl_;
 
+    // the names when legible names are disabled
+    std::unordered_map<SymbolID, std::string> ids_;
+
+    // the names of the IDs which are not in the
+    // corpus, when legible names are disabled
+    mutable std::mutex otherIdsMutex_;
+    mutable std::unordered_map<SymbolID, std::string> otherIds_;
+
+    std::string_view
+    getBase16(SymbolID const& id) const;
+
 public:
     /** Constructor.
 
         Upon construction, the entire table of
-        legible names is built from the corpus.
+        legible names is built from the corpus,
+        including the qualified names, so the
+        functions which return views do not
+        allocate.
     */
     LegibleNames(
         Corpus const& corpus,
@@ -46,7 +64,7 @@ public:
 
     ~LegibleNames() noexcept;
 
-    std::string
+    std::string_view
     getUnqualified(
         SymbolID const& id) const;
 
@@ -54,7 +72,13 @@ public:
     getUnqualified(
         OverloadSet const& os) const;
 
-    std::string
+    /** Return the qualified legible name of a symbol.
+
+        @param id The symbol.
+        @param delim The delimiter between the
+        names, which is either '-' or '/'.
+    */
+    std::string_view
     getQualified(
         SymbolID const& id,
         char delim = '-') const;
@@ -0,0 +1,108 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "OutputSink.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+// Return true if the file has the contents
+bool
+hasContents(
+    std::string_view path,
+    std::string_view contents)
+{
+    namespace fs = llvm::sys::fs;
+
+    // Most changed files also change in size,
+    // so the file is only read if the size matches
+    fs::file_status status;
+    if (fs::status(path, status) ||
+        !fs::is_regular_file(status) ||
+        status.getSize() != contents.size())
+    {
+        return false;
+    }
+    auto buffer = llvm::MemoryBuffer::getFile(path, false, false);
+    if (!buffer)
+    {
+        return false;
+    }
+    llvm::StringRef const data = (*buffer)->getBuffer();
+    return std::string_view(data.data(), data.size()) == contents;
+}
+
+} // (anon)
+
+Expected<void>
+OutputSink::
+createDirectory(std::string_view dir)
+{
+    {
+        std::lock_guard<std::mutex> lock(dirsMutex_);
+        if (dirs_.contains(std::string(dir)))
+        {
+            return {};
+        }
+    }
+    // Threads creating the same directory
+    // concurrently both succeed
+    MRDOCS_TRY(files::createDirectory(dir));
+    std::lock_guard<std::mutex> lock(dirsMutex_);
+    dirs_.emplace(dir);
+    return {};
+}
+
+Expected<void>
+OutputSink::
+write(
+    std::string_view path,
+    std::string_view contents)
+{
+    namespace fs = llvm::sys::fs;
+
+    MRDOCS_TRY(createDirectory(files::getParentDir(path)));
+    if (skipUnchanged_ &&
+        hasContents(path, contents))
+    {
+        unchanged_.fetch_add(1, std::memory_order_relaxed);
+        return {};
+    }
+
+    int fd;
+    if (auto ec = fs::openFileForWrite(path, fd, fs::CD_CreateAlways))
+    {
+        return Unexpected(formatError(
+            "fs::openFileForWrite(\"{}\") returned \"{}\"", path, ec));
+    }
+    // The stream is unbuffered, so the
+    // contents are written with one call
+    llvm::raw_fd_ostream os(fd, true, true);
+    os << llvm::StringRef(contents.data(), contents.size());
+    os.close();
+    if (os.has_error())
+    {
+        auto const ec = os.error();
+        os.clear_error();
+        return Unexpected(formatError(
+            "writing \"{}\" returned \"{}\"", path, ec));
+    }
+    written_.fetch_add(1, std::memory_order_relaxed);
+    return {};
+}
+
+} // mrdocs
+} // clang
@@ -0,0 +1,101 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_SUPPORT_OUTPUTSINK_HPP
+#define MRDOCS_LIB_SUPPORT_OUTPUTSINK_HPP
+
+#include <mrdocs/Support/Error.hpp>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace clang {
+namespace mrdocs {
+
+/** A sink for the files of the output.
+
+    Each file is written with a single call after
+    its contents are rendered to a buffer, so the
+    cost of generating many small pages is not
+    dominated by stream operations.
+
+    The directories which were already created are
+    remembered, so the file system is only queried
+    once for each directory.
+
+    When unchanged files are skipped, a file whose
+    contents are identical to the contents being
+    written is left untouched, so its modification
+    time is preserved for the tools which process
+    the output.
+
+    The functions of this class can be called
+    concurrently.
+*/
+class OutputSink
+{
+    bool skipUnchanged_;
+    std::mutex dirsMutex_;
+    std::unordered_set<std::string> dirs_;
+    std::atomic<std::size_t> written_ = 0;
+    std::atomic<std::size_t> unchanged_ = 0;
+
+    Expected<void>
+    createDirectory(std::string_view dir);
+
+public:
+    /** Constructor.
+
+        @param skipUnchanged Whether files with
+        the same contents are left untouched.
+    */
+    explicit
+    OutputSink(bool skipUnchanged) noexcept
+        : skipUnchanged_(skipUnchanged)
+    {
+    }
+
+    /** Write a file.
+
+        The parent directory of the file is
+        created if it does not exist.
+
+        @param path The absolute path of the file.
+        @param contents The contents of the file.
+    */
+    Expected<void>
+    write(
+        std::string_view path,
+        std::string_view contents);
+
+    /** Return the number of files written.
+    */
+    std::size_t
+    written() const noexcept
+    {
+        return written_.load(std::memory_order_relaxed);
+    }
+
+    /** Return the number of files left untouched.
+    */
+    std::size_t
+    unchanged() const noexcept
+    {
+        return unchanged_.load(std::memory_order_relaxed);
+    }
+};
+
+} // mrdocs
+} // clang
+
+#endif
@@ -0,0 +1,242 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/Trace.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+namespace trace {
+
+std::atomic<bool> enabled_ = false;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct Event
+{
+    char const* name;
+    std::string detail;
+    std::int64_t start;
+    std::int64_t duration;
+};
+
+// The spans recorded by one thread.
+// Only the owning thread appends to
+// the events while recording.
+struct Buffer
+{
+    std::uint32_t tid;
+    std::vector<Event> events;
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+    clock_type::time_point epoch;
+};
+
+Registry&
+registry() noexcept
+{
+    // Never destroyed, so spans of threads
+    // which outlive main can still be recorded
+    static Registry* const r = new Registry;
+    return *r;
+}
+
+Buffer&
+threadBuffer()
+{
+    thread_local Buffer* buffer = nullptr;
+    if (!buffer)
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        auto const tid = static_cast<std::uint32_t>(r.buffers.size() + 1);
+        buffer = r.buffers.emplace_back(
+            std::make_unique<Buffer>(Buffer{ tid, {} })).get();
+    }
+    return *buffer;
+}
+
+std::int64_t
+sinceEpoch(clock_type::time_point t) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        t - registry().epoch).count();
+}
+
+std::string
+validUTF8(std::string_view str)
+{
+    if (llvm::json::isUTF8(str))
+    {
+        return std::string(str);
+    }
+    return llvm::json::fixUTF8(str);
+}
+
+} // (anon)
+
+void
+start()
+{
+    Registry& r = registry();
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.epoch = clock_type::now();
+    }
+    enabled_.store(true, std::memory_order_release);
+}
+
+Expected<void>
+write(std::string_view path)
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    MRDOCS_TRY(files::createDirectory(files::getParentDir(path)));
+    std::error_code ec;
+    llvm::raw_fd_ostream os(path, ec, llvm::sys::fs::OF_None);
+    MRDOCS_CHECK(!ec, formatError(
+        "raw_fd_ostream(\"{}\") returned \"{}\"", path, ec));
+
+    llvm::json::OStream J(os);
+    J.object([&]
+    {
+        J.attribute("displayTimeUnit", "ms");
+        J.attributeArray("traceEvents", [&]
+        {
+            for (auto const& buffer : r.buffers)
+            {
+                J.object([&]
+                {
+                    J.attribute("name", "thread_name");
+                    J.attribute("ph", "M");
+                    J.attribute("pid", 1);
+                    J.attribute("tid", buffer->tid);
+                    J.attributeObject("args", [&]
+                    {
+                        J.attribute("name", buffer->tid == 1 ?
+                            std::string("mrdocs") :
+                            "thread " + std::to_string(buffer->tid));
+                    });
+                });
+                for (Event const& e : buffer->events)
+                {
+                    J.object([&]
+                    {
+                        J.attribute("name", e.name);
+                        J.attribute("cat", "mrdocs");
+                        J.attribute("ph", "X");
+                        J.attribute("pid", 1);
+                        J.attribute("tid", buffer->tid);
+                        J.attribute("ts", e.start);
+                        J.attribute("dur", e.duration);
+                        if (!e.detail.empty())
+                        {
+                            J.attributeObject("args", [&]
+                            {
+                                J.attribute("detail", validUTF8(e.detail));
+                            });
+                        }
+                    });
+                }
+            }
+        });
+    });
+    os << '\n';
+    os.close();
+    if (os.has_error())
+    {
+        ec = os.error();
+        os.clear_error();
+        return Unexpected(formatError(
+            "writing \"{}\" returned \"{}\"", path, ec));
+    }
+    return {};
+}
+
+std::size_t
+size() noexcept
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::size_t n = 0;
+    for (auto const& buffer : r.buffers)
+    {
+        n += buffer->events.size();
+    }
+    return n;
+}
+
+std::chrono::microseconds
+total(std::string_view const name) noexcept
+{
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::int64_t n = 0;
+    for (auto const& buffer : r.buffers)
+    {
+        for (Event const& e : buffer->events)
+        {
+            if (e.name == name)
+            {
+                n += e.duration;
+            }
+        }
+    }
+    return std::chrono::microseconds(n);
+}
+
+void
+reset() noexcept
+{
+    enabled_.store(false, std::memory_order_release);
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto const& buffer : r.buffers)
+    {
+        buffer->events.clear();
+    }
+}
+
+Span::
+~Span()
+{
+    if (!name_)
+    {
+        return;
+    }
+    auto const end = clock_type::now();
+    auto const duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start_);
+    if (duration < minDuration_)
+    {
+        return;
+    }
+    threadBuffer().events.push_back({
+        name_, std::move(detail_),
+        sinceEpoch(start_), duration.count() });
+}
+
+} // trace
+} // mrdocs
+} // clang
@@ -0,0 +1,129 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_LIB_SUPPORT_TRACE_HPP
+#define MRDOCS_LIB_SUPPORT_TRACE_HPP
+
+#include <mrdocs/Support/Error.hpp>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace clang {
+namespace mrdocs {
+namespace trace {
+
+// Whether spans are being recorded
+extern std::atomic<bool> enabled_;
+
+/** Start recording spans.
+
+    Spans created before this function
+    is called are not recorded.
+*/
+void
+start();
+
+/** Return true if spans are being recorded.
+*/
+inline
+bool
+enabled() noexcept
+{
+    return enabled_.load(std::memory_order_acquire);
+}
+
+/** Write the recorded spans to a file.
+
+    The file uses the Chrome trace event format,
+    which can be opened with `chrome://tracing`
+    or https://ui.perfetto.dev.
+
+    No spans should be recorded while the
+    file is written.
+*/
+Expected<void>
+write(std::string_view path);
+
+/** Return the number of recorded spans.
+*/
+std::size_t
+size() noexcept;
+
+/** Return the total duration of the recorded spans with a name.
+
+    Spans recorded by different threads
+    are added, so the total of spans which
+    run concurrently can exceed the time
+    elapsed since recording started.
+*/
+std::chrono::microseconds
+total(std::string_view name) noexcept;
+
+/** Discard the recorded spans and stop recording.
+*/
+void
+reset() noexcept;
+
+/** A span recorded from its construction to its destruction.
+
+    The span is recorded with the thread which
+    destroys it, so it should not be moved to
+    another thread. When tracing is disabled,
+    the span does nothing.
+*/
+class Span
+{
+    using clock_type = std::chrono::steady_clock;
+
+    char const* name_ = nullptr;
+    std::string detail_;
+    clock_type::time_point start_;
+    std::chrono::microseconds minDuration_{};
+
+public:
+    /** Constructor.
+
+        @param name The name of the span, which
+        must be a string literal.
+
+        @param detail A description of the
+        span, such as the name of a file.
+
+        @param minDuration The span is discarded
+        if it takes less than this duration.
+    */
+    explicit
+    Span(
+        char const* name,
+        std::string_view detail = {},
+        std::chrono::microseconds minDuration = {})
+    {
+        if (enabled())
+        {
+            name_ = name;
+            detail_ = detail;
+            minDuration_ = minDuration;
+            start_ = clock_type::now();
+        }
+    }
+
+    Span(Span const&) = delete;
+    Span& operator=(Span const&) = delete;
+
+    ~Span();
+};
+
+} // trace
+} // mrdocs
+} // clang
+
+#endif
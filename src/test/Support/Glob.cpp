@@ -10,6 +10,9 @@
 
 #include <mrdocs/Support/Glob.hpp>
 #include <test_suite/test_suite.hpp>
+#include <algorithm>
+#include <string_view>
+#include <vector>
 
 namespace clang::mrdocs {
 
@@ -551,6 +554,105 @@ struct Glob_test
                 BOOST_TEST_NOT(glob.matchPatternPrefix("std"));
             }
         }
+
+        // pattern sets
+        {
+            std::vector<std::string_view> const patterns = {
+                "ns::c::*",
+                "ns::c",
+                "ns::**::f",
+                "ns::d{e,f}",
+                "std::vector",
+                "std::*::f?o",
+                "[a-c]::*",
+                "*::impl",
+                "ns",
+                ""
+            };
+            std::vector<std::string_view> const names = {
+                "",
+                "n",
+                "ns",
+                "ns::",
+                "ns::c",
+                "ns::c::",
+                "ns::c::d",
+                "ns::c::d::f",
+                "ns::de",
+                "ns::dg",
+                "ns::x::y::f",
+                "std",
+                "std::vec",
+                "std::vector",
+                "std::vector::foo",
+                "std::vector::fao",
+                "std::vector::fo",
+                "b::x",
+                "d::x",
+                "x::impl",
+                "x::y::impl"
+            };
+
+            // default constructed
+            {
+                SymbolGlobPatternSet set;
+                BOOST_TEST(set.empty());
+                BOOST_TEST_NOT(set.match(""));
+                BOOST_TEST_NOT(set.matchPatternPrefix(""));
+            }
+
+            // the set matches if any pattern matches
+            auto const expect = [](bool const actual, bool const expected)
+            {
+                if (expected)
+                {
+                    BOOST_TEST(actual);
+                }
+                else
+                {
+                    BOOST_TEST_NOT(actual);
+                }
+            };
+            std::vector<SymbolGlobPattern> globs;
+            for (std::string_view pattern : patterns)
+            {
+                auto globExp = SymbolGlobPattern::create(pattern);
+                BOOST_TEST(globExp);
+                globs.push_back(*globExp);
+            }
+            for (std::size_t n = 0; n <= globs.size(); ++n)
+            {
+                std::vector<SymbolGlobPattern> const subset(
+                    globs.begin(), globs.begin() + n);
+                SymbolGlobPatternSet const set(subset);
+                expect(set.empty(), n == 0);
+                for (std::string_view name : names)
+                {
+                    bool const match = std::ranges::any_of(subset,
+                        [&](SymbolGlobPattern const& glob)
+                        {
+                            return glob.match(name);
+                        });
+                    bool const prefix = std::ranges::any_of(subset,
+                        [&](SymbolGlobPattern const& glob)
+                        {
+                            return glob.matchPatternPrefix(name);
+                        });
+                    expect(set.match(name), match);
+                    expect(set.matchPatternPrefix(name), prefix);
+
+                    // resume the walk of every prefix of the name
+                    for (std::size_t i = 0; i <= name.size(); ++i)
+                    {
+                        auto state = set.start();
+                        set.advance(state, name.substr(0, i));
+                        set.advance(state, name);
+                        expect(set.match(state, name), match);
+                        expect(set.matchPatternPrefix(state, name), prefix);
+                    }
+                }
+            }
+        }
     }
 };
 
@@ -0,0 +1,120 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "test/lib/Lib/TestProject.hpp"
+#include <test_suite/test_suite.hpp>
+#include <fmt/format.h>
+#include <string>
+
+namespace clang {
+namespace mrdocs {
+
+struct ParallelJavadoc_test
+{
+    void
+    run()
+    {
+        TestProject project("parallel-javadoc");
+        BOOST_TEST(project);
+        if (!project)
+        {
+            return;
+        }
+
+        // Enough documented symbols for several tasks
+        // per thread, with redeclarations whose comments
+        // are merged in order, references to other
+        // symbols, and a comment with a bad command
+        std::string header =
+            "namespace ns {\n"
+            "/** A class\n"
+            "\n"
+            "    @see ns::f0\n"
+            "*/\n"
+            "class C;\n"
+            "\n"
+            "/** More about the class\n"
+            "*/\n"
+            "class C {};\n"
+            "\n"
+            "/** A bad command @notacommand\n"
+            "*/\n"
+            "void bad();\n";
+        for (int i = 0; i < 64; ++i)
+        {
+            header += fmt::format(
+                "\n"
+                "/** Function {0}\n"
+                "\n"
+                "    Calls @ref ns::f{1}.\n"
+                "\n"
+                "    @param c The class\n"
+                "    @return The number {0}\n"
+                "*/\n"
+                "int f{0}(C c);\n"
+                "\n"
+                "/// Redeclaration of function {0}\n"
+                "int f{0}(C c);\n",
+                i, (i + 1) % 64);
+        }
+        header += "} // ns\n";
+        BOOST_TEST(project.write("include/lib.hpp", header));
+        BOOST_TEST(project.addSource("src/lib.cpp",
+            "#include <lib.hpp>\n"
+            "\n"
+            "/// The definition of function 0\n"
+            "int ns::f0(C) { return 0; }\n"));
+
+        auto settings = project.settings();
+        BOOST_TEST(settings);
+        if (!settings)
+        {
+            return;
+        }
+        std::string serial;
+        {
+            auto corpus = project.build(*settings);
+            BOOST_TEST(corpus);
+            if (corpus)
+            {
+                auto docs = generateString(**corpus);
+                BOOST_TEST(docs);
+                if (docs)
+                {
+                    serial = std::move(*docs);
+                }
+            }
+        }
+        BOOST_TEST(serial.find("More about the class") != std::string::npos);
+        BOOST_TEST(serial.find("Redeclaration of function 63") != std::string::npos);
+
+        // The comments converted in parallel
+        // produce the same documentation
+        settings->parallelJavadoc = true;
+        auto corpus = project.build(*settings);
+        BOOST_TEST(corpus);
+        if (corpus)
+        {
+            auto docs = generateString(**corpus);
+            BOOST_TEST(docs);
+            if (docs)
+            {
+                BOOST_TEST(*docs == serial);
+            }
+        }
+    }
+};
+
+TEST_SUITE(
+    ParallelJavadoc_test,
+    "clang.mrdocs.ParallelJavadoc");
+
+} // mrdocs
+} // clang
@@ -48,6 +48,23 @@ tag_invoke(
     io.map("y", x.y);
 }
 
+struct Z {
+    mutable int evaluated = 0;
+};
+
+template <class IO>
+void
+tag_invoke(
+    dom::LazyObjectMapTag,
+    IO& io,
+    Z const& z)
+{
+    io.defer("a", [&z]{ ++z.evaluated; return 1; });
+    io.map("b", 2);
+    io.defer("c", [&z]{ ++z.evaluated; return 3; });
+    io.defer("c", [&z]{ ++z.evaluated; return 4; });
+}
+
 struct LazyObject_test
 {
     void
@@ -234,6 +251,65 @@ struct LazyObject_test
         }
     }
 
+    void
+    testKeys()
+    {
+        X x;
+        LazyObjectImpl<X> obj(x);
+
+        // missing keys
+        {
+            BOOST_TEST(obj.get("x").isUndefined());
+            BOOST_TEST_NOT(obj.exists("x"));
+            BOOST_TEST_NOT(obj.exists(""));
+        }
+
+        // deferred values are computed on each access
+        {
+            BOOST_TEST(obj.get("si") == "hello123");
+            x.s = "bye";
+            BOOST_TEST(obj.get("si") == "bye123");
+        }
+    }
+
+    void
+    testStop()
+    {
+        Z z;
+        LazyObjectImpl<Z> obj(z);
+
+        // only the value of the key is computed,
+        // and the mapping stops once it is found
+        {
+            BOOST_TEST(obj.get("b") == 2);
+            BOOST_TEST(z.evaluated == 0);
+            BOOST_TEST(obj.get("c") == 3);
+            BOOST_TEST(z.evaluated == 1);
+            BOOST_TEST(obj.exists("c"));
+            BOOST_TEST(obj.size() == 4);
+            BOOST_TEST(z.evaluated == 1);
+        }
+
+        // visit stops when the function returns false
+        {
+            std::size_t count = 0;
+            obj.visit([&count](String const&, Value const&) {
+                ++count;
+                return false;
+            });
+            BOOST_TEST(count == 1);
+            BOOST_TEST(z.evaluated == 2);
+        }
+
+        // the overlay takes precedence
+        {
+            obj.set("c", 5);
+            BOOST_TEST(obj.get("c") == 5);
+            BOOST_TEST(obj.size() == 3);
+            BOOST_TEST(z.evaluated == 2);
+        }
+    }
+
     void run()
     {
         testConstructor();
@@ -242,6 +318,8 @@ struct LazyObject_test
         testSet();
         testExists();
         testVisit();
+        testKeys();
+        testStop();
     }
 };
 
@@ -0,0 +1,117 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Dom/StringPool.hpp"
+#include <test_suite/test_suite.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+namespace dom {
+
+struct StringPool_test
+{
+    void
+    intern_test()
+    {
+        StringPool pool;
+
+        // empty strings
+        {
+            String s = pool.intern("");
+            BOOST_TEST(s.empty());
+            BOOST_TEST(pool.size() == 0);
+        }
+
+        // the same contents share the same buffer
+        {
+            std::string str = "hello";
+            String s1 = pool.intern(str);
+            str[0] = 'j';
+            String s2 = pool.intern("hello");
+            String s3 = pool.intern(str);
+            BOOST_TEST(s1 == "hello");
+            BOOST_TEST(s2 == "hello");
+            BOOST_TEST(s3 == "jello");
+            BOOST_TEST(s1.data() == s2.data());
+            BOOST_TEST(s1.data() != s3.data());
+            BOOST_TEST(pool.size() == 2);
+
+            // copies reference the same buffer
+            String s4 = s1;
+            BOOST_TEST(s4.data() == s1.data());
+            BOOST_TEST(s4.size() == 5);
+            BOOST_TEST_NOT(s4.data()[s4.size()]);
+        }
+
+        // strings larger than a block
+        {
+            std::string const str(100000, 'x');
+            String s = pool.intern(str);
+            BOOST_TEST(s.get() == str);
+            BOOST_TEST(pool.intern(str).data() == s.data());
+        }
+
+        // strings with null characters are copied
+        {
+            std::string_view const str("a\0b", 3);
+            String s = pool.intern(str);
+            BOOST_TEST(s.get() == str);
+            BOOST_TEST(pool.intern(str).data() != s.data());
+        }
+    }
+
+    void
+    thread_test()
+    {
+        StringPool pool;
+        std::vector<std::thread> threads;
+        std::vector<std::vector<String>> results(4);
+        for (std::size_t t = 0; t < results.size(); ++t)
+        {
+            threads.emplace_back([&pool, &result = results[t]]
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    result.push_back(pool.intern(std::to_string(i)));
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        BOOST_TEST(pool.size() == 1000);
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+            BOOST_TEST(results[0][i] == std::to_string(i));
+            for (std::size_t t = 1; t < results.size(); ++t)
+            {
+                BOOST_TEST(results[t][i].data() == results[0][i].data());
+            }
+        }
+    }
+
+    void run()
+    {
+        intern_test();
+        thread_test();
+    }
+};
+
+TEST_SUITE(
+    StringPool_test,
+    "clang.mrdocs.dom.StringPool");
+
+} // dom
+} // mrdocs
+} // clang
@@ -0,0 +1,148 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include <mrdocs/Corpus.hpp>
+#include <mrdocs/Metadata.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <test_suite/test_suite.hpp>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+class TestConfig : public Config
+{
+    mutable ThreadPool threadPool_{2};
+    Settings settings_;
+    dom::Object object_;
+
+public:
+    ThreadPool&
+    threadPool() const noexcept override
+    {
+        return threadPool_;
+    }
+
+    Settings const&
+    settings() const noexcept override
+    {
+        return settings_;
+    }
+
+    dom::Object const&
+    object() const override
+    {
+        return object_;
+    }
+};
+
+// A corpus which only implements the pure
+// virtual functions, like a corpus written
+// before lookup, parents and qualifiedName
+// became virtual
+class TestCorpus : public Corpus
+{
+    std::vector<std::unique_ptr<Info>> infos_;
+    std::vector<Info const*> index_;
+
+public:
+    TestCorpus(
+        Config const& config,
+        std::vector<std::unique_ptr<Info>> infos)
+        : Corpus(config)
+        , infos_(std::move(infos))
+    {
+        for (auto const& I : infos_)
+        {
+            index_.push_back(I.get());
+        }
+        std::ranges::sort(index_, {}, &Info::id);
+    }
+
+    iterator
+    begin() const noexcept override
+    {
+        return iterator(index_.data());
+    }
+
+    iterator
+    end() const noexcept override
+    {
+        return iterator(index_.data() + index_.size());
+    }
+
+    Info const*
+    find(SymbolID const& id) const noexcept override
+    {
+        auto it = std::ranges::lower_bound(index_, id, {}, &Info::id);
+        if (it == index_.end() || (*it)->id != id)
+        {
+            return nullptr;
+        }
+        return *it;
+    }
+};
+
+} // (anon)
+
+struct Corpus_test
+{
+    void
+    run()
+    {
+        SymbolID const a("aaaaaaaaaaaaaaaaaaaa");
+        SymbolID const b("bbbbbbbbbbbbbbbbbbbb");
+
+        std::vector<std::unique_ptr<Info>> infos;
+        auto global = std::make_unique<NamespaceInfo>(SymbolID::global);
+        global->Members.push_back(a);
+        auto A = std::make_unique<NamespaceInfo>(a);
+        A->Name = "A";
+        A->Parent = SymbolID::global;
+        A->Members.push_back(b);
+        auto B = std::make_unique<NamespaceInfo>(b);
+        B->Name = "B";
+        B->Parent = a;
+        infos.push_back(std::move(global));
+        infos.push_back(std::move(A));
+        infos.push_back(std::move(B));
+
+        TestConfig config;
+        TestCorpus corpus(config, std::move(infos));
+        Info const& I = corpus.get(b);
+
+        // The default implementations build
+        // their tables the first time they are used
+        BOOST_TEST(corpus.qualifiedName(I) == "A::B");
+        auto const parents = corpus.parents(I);
+        BOOST_TEST(parents.size() == 2);
+        BOOST_TEST(std::ranges::equal(
+            parents, std::vector<SymbolID>({ SymbolID::global, a })));
+
+        std::string temp;
+        corpus.qualifiedName(I, temp);
+        BOOST_TEST(temp == "A::B");
+
+        BOOST_TEST(corpus.lookup(SymbolID::global, "A::B") == &I);
+        BOOST_TEST(corpus.lookup(b, "A") == corpus.find(a));
+        BOOST_TEST(corpus.lookup(SymbolID::global, "C") == nullptr);
+    }
+};
+
+TEST_SUITE(
+    Corpus_test,
+    "clang.mrdocs.Corpus");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,268 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/CorpusCache.hpp"
+#include "lib/Metadata/Serialize.hpp"
+#include "test/lib/Lib/TestProject.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <test_suite/test_suite.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Process.h>
+#include <string>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+// Set the modification time of a file
+bool
+setModificationTime(
+    std::string const& path,
+    std::uint64_t time)
+{
+    namespace fs = llvm::sys::fs;
+    int fd;
+    if (fs::openFileForWrite(path, fd, fs::CD_OpenExisting, fs::OF_Append))
+    {
+        return false;
+    }
+    llvm::sys::TimePoint<> const tp{
+        llvm::sys::TimePoint<>::duration(time) };
+    bool const ok = !fs::setLastAccessAndModificationTime(fd, tp);
+    llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+    return ok;
+}
+
+} // (anon)
+
+struct CorpusCache_test
+{
+    void
+    testInvalidation()
+    {
+        TestProject project("corpus-cache");
+        BOOST_TEST(project);
+        if (!project)
+        {
+            return;
+        }
+        auto settings = project.settings();
+        BOOST_TEST(settings);
+        if (!settings)
+        {
+            return;
+        }
+        auto config = project.config(*settings);
+        BOOST_TEST(config);
+        if (!config)
+        {
+            return;
+        }
+        std::string const dir = project.path("cache");
+        BOOST_TEST(files::createDirectory(dir));
+        CorpusCache cache(dir, **config);
+
+        std::string const header = project.path("include/a.hpp");
+        BOOST_TEST(project.write("include/a.hpp", "struct A;\n"));
+
+        // An entry with every member
+        SymbolID const id("0123456789abcdefghij");
+        SymbolID const borrowed("abcdefghij0123456789");
+        auto makeEntry = [&]
+        {
+            CorpusCache::Entry entry;
+            auto dep = CorpusCache::getDependency(header);
+            BOOST_TEST(dep);
+            if (dep)
+            {
+                entry.Dependencies.push_back(std::move(*dep));
+            }
+            entry.Provided.emplace_back(id, ExtractionMode::Regular);
+            entry.Borrowed.push_back(borrowed);
+            entry.Diags.warn("a warning");
+            InfoSet info;
+            auto I = std::make_unique<NamespaceInfo>(id);
+            I->Name = "ns";
+            info.emplace(std::move(I));
+            BinaryWriter(entry.Results).writeInfoSet(info);
+            return entry;
+        };
+        CorpusCache::Entry const entry = makeEntry();
+        BOOST_TEST(cache.store("k", entry));
+
+        // the entry is loaded while the file is unchanged
+        {
+            auto loaded = cache.load("k");
+            BOOST_TEST(loaded);
+            if (loaded)
+            {
+                BOOST_TEST(loaded->Dependencies.size() == 1);
+                BOOST_TEST(loaded->Provided == entry.Provided);
+                BOOST_TEST(loaded->Borrowed == entry.Borrowed);
+                BOOST_TEST(loaded->Diags.messages() == entry.Diags.messages());
+                BOOST_TEST(loaded->Results == entry.Results);
+            }
+            BOOST_TEST(!cache.load("other"));
+        }
+
+        // another modification time
+        {
+            std::uint64_t const mtime = entry.Dependencies.front().ModificationTime;
+            BOOST_TEST(setModificationTime(header, mtime + 10'000'000'000ull));
+            BOOST_TEST(!cache.load("k"));
+            BOOST_TEST(setModificationTime(header, mtime));
+            BOOST_TEST(cache.load("k"));
+        }
+
+        // another size with the same modification time
+        {
+            std::uint64_t const mtime = entry.Dependencies.front().ModificationTime;
+            BOOST_TEST(project.write("include/a.hpp", "struct A {};\n"));
+            BOOST_TEST(setModificationTime(header, mtime));
+            BOOST_TEST(!cache.load("k"));
+        }
+
+        // a removed file
+        {
+            BOOST_TEST(cache.store("k", makeEntry()));
+            BOOST_TEST(cache.load("k"));
+            llvm::sys::fs::remove(header);
+            BOOST_TEST(!cache.load("k"));
+        }
+
+        // a damaged entry is ignored
+        {
+            std::string data;
+            BinaryWriter w(data);
+            w.writeString("mrdocs-tu-cache");
+            w.writeUInt(binaryFormatVersion);
+            w.writeUInt(std::uint64_t(1) << 62);
+            BOOST_TEST(project.write("cache/damaged.bin", data));
+            BOOST_TEST(!cache.load("damaged"));
+        }
+    }
+
+    void
+    testReplay()
+    {
+        // The translation units are extracted in
+        // order, so the first one extracts the
+        // definitions in the header and the second
+        // one only extracts their declarations
+        TestProject project("corpus-cache-replay", 1);
+        BOOST_TEST(project);
+        if (!project)
+        {
+            return;
+        }
+        BOOST_TEST(project.write("include/lib.hpp",
+            "/// A class\n"
+            "struct S\n"
+            "{\n"
+            "    /// A member function\n"
+            "    void f();\n"
+            "};\n"));
+        BOOST_TEST(project.addSource("src/a.cpp",
+            "#include <lib.hpp>\n"
+            "\n"
+            "/// A function of a\n"
+            "void a();\n"));
+        BOOST_TEST(project.addSource("src/b.cpp",
+            "#include <lib.hpp>\n"
+            "\n"
+            "/// A function of b\n"
+            "void b();\n"));
+
+        auto settings = project.settings();
+        BOOST_TEST(settings);
+        if (!settings)
+        {
+            return;
+        }
+        auto cached = *settings;
+        cached.cacheDir = project.path("cache");
+
+        BOOST_TEST(project.build(cached));
+
+        // One of the entries borrowed the definitions
+        {
+            auto config = project.config(cached);
+            BOOST_TEST(config);
+            if (!config)
+            {
+                return;
+            }
+            CorpusCache cache(cached.cacheDir, **config);
+            std::size_t entries = 0;
+            std::size_t borrowing = 0;
+            std::error_code ec;
+            for (llvm::sys::fs::directory_iterator it(cached.cacheDir, ec), end;
+                 it != end && !ec; it.increment(ec))
+            {
+                llvm::StringRef const path = it->path();
+                if (llvm::sys::path::extension(path) != ".bin")
+                {
+                    continue;
+                }
+                auto entry = cache.load(llvm::sys::path::stem(path));
+                BOOST_TEST(entry);
+                ++entries;
+                borrowing += entry && !entry->Borrowed.empty();
+            }
+            BOOST_TEST(entries == 2);
+            BOOST_TEST(borrowing == 1);
+        }
+
+        // Each translation unit alone is extracted with
+        // the definitions, whether its entry borrowed
+        // them or not
+        for (std::string_view removed : { "src/b.cpp", "src/a.cpp" })
+        {
+            project.removeSource(removed);
+
+            auto fromCache = project.build(cached);
+            BOOST_TEST(fromCache);
+            auto direct = project.build(*settings);
+            BOOST_TEST(direct);
+            if (fromCache && direct)
+            {
+                auto expected = generateString(**direct);
+                auto actual = generateString(**fromCache);
+                BOOST_TEST(expected);
+                BOOST_TEST(actual);
+                if (expected && actual)
+                {
+                    BOOST_TEST(*actual == *expected);
+                    BOOST_TEST(actual->find("A member function") != std::string::npos);
+                }
+            }
+
+            // The file is not written again, so
+            // its entry stays valid
+            project.addSource(removed);
+        }
+    }
+
+    void
+    run()
+    {
+        testInvalidation();
+        testReplay();
+    }
+};
+
+TEST_SUITE(
+    CorpusCache_test,
+    "clang.mrdocs.Lib.CorpusCache");
+
+} // mrdocs
+} // clang
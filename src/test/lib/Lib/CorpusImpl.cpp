@@ -0,0 +1,253 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/CorpusImpl.hpp"
+#include "lib/Metadata/Serialize.hpp"
+#include "test/lib/Lib/TestProject.hpp"
+#include <mrdocs/Version.hpp>
+#include <test_suite/test_suite.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <string>
+
+namespace clang {
+namespace mrdocs {
+
+struct CorpusImpl_test
+{
+    TestProject project_{"corpus-impl"};
+    std::shared_ptr<ConfigImpl const> config_;
+
+    // Return the error of loading a file, or an
+    // empty string if the corpus was loaded
+    std::string
+    loadError(std::string_view name)
+    {
+        auto corpus = CorpusImpl::load(config_, project_.path(name));
+        if (corpus)
+        {
+            return {};
+        }
+        return corpus.error().message();
+    }
+
+    void
+    testSaveLoad(Corpus const& direct)
+    {
+        std::string const path = project_.path("out/corpus.bin");
+        BOOST_TEST(CorpusImpl::save(direct, path));
+        auto loaded = CorpusImpl::load(config_, path);
+        BOOST_TEST(loaded);
+        if (!loaded)
+        {
+            return;
+        }
+        BOOST_TEST((*loaded)->size() == direct.size());
+
+        // The file is replaced, and the
+        // temporary file is removed
+        BOOST_TEST(CorpusImpl::save(**loaded, path));
+        std::size_t files = 0;
+        std::error_code ec;
+        for (llvm::sys::fs::directory_iterator it(project_.path("out"), ec), end;
+             it != end && !ec; it.increment(ec))
+        {
+            ++files;
+        }
+        BOOST_TEST(files == 1);
+
+        // The documentation generated from the loaded
+        // corpus is the documentation of a direct run
+        for (std::string_view generator : { "xml", "adoc" })
+        {
+            auto expected = generateString(direct, generator);
+            auto actual = generateString(**loaded, generator);
+            BOOST_TEST(expected);
+            BOOST_TEST(actual);
+            if (expected && actual)
+            {
+                BOOST_TEST(*actual == *expected);
+            }
+        }
+    }
+
+    void
+    testErrors()
+    {
+        std::string saved;
+        {
+            auto buffer = llvm::MemoryBuffer::getFile(
+                project_.path("out/corpus.bin"));
+            BOOST_TEST(buffer);
+            if (!buffer)
+            {
+                return;
+            }
+            saved = (*buffer)->getBuffer().str();
+        }
+
+        // missing file
+        BOOST_TEST_NOT(loadError("out/missing.bin").empty());
+
+        // bad magic
+        {
+            std::string data;
+            BinaryWriter w(data);
+            w.writeString("mrdocs-cache");
+            BOOST_TEST(project_.write("out/magic.bin", data + saved));
+            std::string const error = loadError("out/magic.bin");
+            BOOST_TEST(error.find("is not a corpus file") != std::string::npos);
+        }
+
+        // version mismatch
+        {
+            std::string data;
+            BinaryWriter w(data);
+            w.writeString("mrdocs-corpus");
+            w.writeUInt(binaryFormatVersion + 1);
+            w.writeString(project_version);
+            w.writeString(project_version_build);
+            w.writeUInt(0);
+            BOOST_TEST(project_.write("out/format.bin", data));
+            std::string const error = loadError("out/format.bin");
+            BOOST_TEST(error.find("another version") != std::string::npos);
+        }
+        {
+            std::string data;
+            BinaryWriter w(data);
+            w.writeString("mrdocs-corpus");
+            w.writeUInt(binaryFormatVersion);
+            w.writeString("0.0.0-other");
+            w.writeString(project_version_build);
+            w.writeUInt(0);
+            BOOST_TEST(project_.write("out/version.bin", data));
+            std::string const error = loadError("out/version.bin");
+            BOOST_TEST(error.find("another version") != std::string::npos);
+        }
+
+        // trailing data
+        {
+            BOOST_TEST(project_.write("out/trailing.bin", saved + '\0'));
+            std::string const error = loadError("out/trailing.bin");
+            BOOST_TEST(error.find("trailing data") != std::string::npos);
+        }
+
+        // a count larger than the data
+        {
+            std::string data;
+            BinaryWriter w(data);
+            w.writeString("mrdocs-corpus");
+            w.writeUInt(binaryFormatVersion);
+            w.writeString(project_version);
+            w.writeString(project_version_build);
+            w.writeUInt(std::uint64_t(1) << 62);
+            BOOST_TEST(project_.write("out/count.bin", data));
+            std::string const error = loadError("out/count.bin");
+            BOOST_TEST(error.find("malformed") != std::string::npos);
+        }
+
+        // truncated data
+        {
+            BOOST_TEST(project_.write("out/truncated.bin",
+                std::string_view(saved).substr(0, saved.size() / 2)));
+            std::string const error = loadError("out/truncated.bin");
+            BOOST_TEST(error.find("malformed") != std::string::npos);
+        }
+
+        // the saved file is still loaded
+        BOOST_TEST(loadError("out/corpus.bin").empty());
+    }
+
+    void
+    run()
+    {
+        BOOST_TEST(project_);
+        if (!project_)
+        {
+            return;
+        }
+        BOOST_TEST(project_.write("include/lib.hpp",
+            "namespace ns {\n"
+            "\n"
+            "/** A class template\n"
+            "\n"
+            "    @tparam T The type\n"
+            "    @see ns::f\n"
+            "*/\n"
+            "template<class T>\n"
+            "class C\n"
+            "{\n"
+            "public:\n"
+            "    /// Construct from a value\n"
+            "    explicit C(T const& v);\n"
+            "\n"
+            "    /// Return the value\n"
+            "    T const& get() const noexcept;\n"
+            "\n"
+            "    /// Set the value\n"
+            "    void set(T v);\n"
+            "    /// Set the value from another object\n"
+            "    void set(C const& other);\n"
+            "\n"
+            "private:\n"
+            "    T v_;\n"
+            "};\n"
+            "\n"
+            "/** A function\n"
+            "\n"
+            "    Makes a @ref C.\n"
+            "\n"
+            "    @param x The value\n"
+            "    @return The object\n"
+            "*/\n"
+            "C<int> f(int x);\n"
+            "\n"
+            "/// A scoped enumeration\n"
+            "enum class E { a, b };\n"
+            "\n"
+            "/// An alias\n"
+            "using CI = C<int>;\n"
+            "} // ns\n"));
+        BOOST_TEST(project_.addSource("src/lib.cpp",
+            "#include <lib.hpp>\n"
+            "\n"
+            "ns::C<int> ns::f(int x) { return C<int>(x); }\n"));
+
+        auto settings = project_.settings();
+        BOOST_TEST(settings);
+        if (!settings)
+        {
+            return;
+        }
+        auto config = project_.config(*settings);
+        BOOST_TEST(config);
+        if (!config)
+        {
+            return;
+        }
+        config_ = *config;
+        auto direct = project_.build(*settings);
+        BOOST_TEST(direct);
+        if (!direct)
+        {
+            return;
+        }
+
+        testSaveLoad(**direct);
+        testErrors();
+    }
+};
+
+TEST_SUITE(
+    CorpusImpl_test,
+    "clang.mrdocs.Lib.CorpusImpl");
+
+} // mrdocs
+} // clang
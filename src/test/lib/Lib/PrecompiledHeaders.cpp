@@ -0,0 +1,196 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "TestProject.hpp"
+#include "lib/Lib/PrecompiledHeaders.hpp"
+#include <test_suite/test_suite.hpp>
+#include <clang/Tooling/CompilationDatabase.h>
+#include <fmt/format.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+struct PrecompiledHeaders_test
+{
+    // Return the number of bytes skipped
+    // by a translation unit, or 0
+    static
+    std::size_t
+    skippedBytes(
+        PrecompiledHeaders& pch,
+        std::string const& file)
+    {
+        auto adjuster = pch.adjuster(file);
+        if (!adjuster)
+        {
+            return 0;
+        }
+        tooling::CommandLineArguments const args =
+            adjuster({ "clang++", file }, file);
+        for (std::string const& arg : args)
+        {
+            if (std::size_t n = 0;
+                std::sscanf(arg.c_str(), "-preamble-bytes=%zu,1", &n) == 1)
+            {
+                return n;
+            }
+        }
+        return 0;
+    }
+
+    void
+    testGroups()
+    {
+        TestProject project("pch-groups");
+        BOOST_TEST(project);
+        if (!project)
+        {
+            return;
+        }
+        BOOST_TEST(project.write("include/x.hpp", "struct X {};\n"));
+        BOOST_TEST(project.write("include/y.hpp", "struct Y {};\n"));
+        BOOST_TEST(project.write("include/z.hpp", "struct Z {};\n"));
+        BOOST_TEST(project.write("src/a.hpp", "struct A {};\n"));
+
+        // The files begin with different comments and
+        // their own headers after the shared includes
+        std::string const a =
+            "// Copyright a\n"
+            "#include <x.hpp>\n"
+            "#include <y.hpp>\n"
+            "#include \"a.hpp\"\n"
+            "int a;\n";
+        std::string const b =
+            "/* Copyright b */\n"
+            "#include <x.hpp>\n"
+            "#  include   <y.hpp> // y\n"
+            "\n"
+            "#include <z.hpp>\n"
+            "int b;\n";
+        std::string const c =
+            "#include <x.hpp>\n"
+            "int c;\n";
+        std::string const d =
+            "#include \"a.hpp\"\n"
+            "#include <x.hpp>\n"
+            "int d;\n";
+        BOOST_TEST(project.write("src/a.cpp", a));
+        BOOST_TEST(project.write("src/b.cpp", b));
+        BOOST_TEST(project.write("src/c.cpp", c));
+        BOOST_TEST(project.write("src/d.cpp", d));
+
+        tooling::FixedCompilationDatabase compilations(
+            project.path("."),
+            { "-std=c++20", "-I" + project.path("include") });
+        std::vector<std::string> const files = {
+            project.path("src/a.cpp"),
+            project.path("src/b.cpp"),
+            project.path("src/c.cpp"),
+            project.path("src/d.cpp") };
+        PrecompiledHeaders pch(
+            compilations, files,
+            std::make_shared<PCHContainerOperations>());
+
+        // a and b share the longest prefix, and skip
+        // it along with the comments which follow it
+        BOOST_TEST(skippedBytes(pch, files[0]) == a.find("#include \"a.hpp\""));
+        BOOST_TEST(skippedBytes(pch, files[1]) == b.find("#include <z.hpp>"));
+
+        // c only shares a shorter prefix, and
+        // d begins with its own header
+        BOOST_TEST(skippedBytes(pch, files[2]) == 0);
+        BOOST_TEST(skippedBytes(pch, files[3]) == 0);
+    }
+
+    void
+    testExtract()
+    {
+        TestProject project("pch-extract");
+        BOOST_TEST(project);
+        if (!project)
+        {
+            return;
+        }
+        BOOST_TEST(project.write("system/lib.hpp",
+            "/** A type from a system header\n"
+            "*/\n"
+            "struct SystemType {};\n"));
+        BOOST_TEST(project.write("include/common.hpp",
+            "#include <lib.hpp>\n"
+            "/** A function of the project\n"
+            "*/\n"
+            "SystemType f();\n"));
+        for (int i = 0; i < 3; ++i)
+        {
+            BOOST_TEST(project.addSource(
+                fmt::format("src/tu{}.cpp", i),
+                fmt::format(
+                    "#include <common.hpp>\n"
+                    "#include <lib.hpp>\n"
+                    "/// Function {0}\n"
+                    "void g{0}();\n", i)));
+        }
+
+        auto settings = project.settings();
+        BOOST_TEST(settings);
+        if (!settings)
+        {
+            return;
+        }
+        std::string expected;
+        {
+            auto corpus = project.build(*settings);
+            BOOST_TEST(corpus);
+            if (corpus)
+            {
+                auto docs = generateString(**corpus);
+                BOOST_TEST(docs);
+                if (docs)
+                {
+                    expected = std::move(*docs);
+                }
+            }
+        }
+        BOOST_TEST(expected.find("A type from a system header") != std::string::npos);
+        BOOST_TEST(expected.find("Function 2") != std::string::npos);
+
+        // The same symbols and documentation are
+        // extracted with precompiled headers
+        settings->precompiledHeaders = true;
+        auto corpus = project.build(*settings);
+        BOOST_TEST(corpus);
+        if (corpus)
+        {
+            auto docs = generateString(**corpus);
+            BOOST_TEST(docs);
+            if (docs)
+            {
+                BOOST_TEST(*docs == expected);
+            }
+        }
+    }
+
+    void
+    run()
+    {
+        testGroups();
+        testExtract();
+    }
+};
+
+TEST_SUITE(
+    PrecompiledHeaders_test,
+    "clang.mrdocs.PrecompiledHeaders");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,189 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "TestProject.hpp"
+#include "lib/Lib/CorpusImpl.hpp"
+#include "lib/Lib/MrDocsCompilationDatabase.hpp"
+#include <mrdocs/Generators.hpp>
+#include <mrdocs/Support/Path.hpp>
+#include <clang/Tooling/JSONCompilationDatabase.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/raw_ostream.h>
+#include <unordered_map>
+
+namespace clang {
+namespace mrdocs {
+
+TestProject::
+TestProject(
+    llvm::StringRef prefix,
+    unsigned concurrency)
+    : dir_(prefix)
+    , threadPool_(concurrency)
+{
+}
+
+std::string
+TestProject::
+path(std::string_view name) const
+{
+    return files::makePosixStyle(files::appendPath(dir_.path(), name));
+}
+
+Expected<void>
+TestProject::
+write(
+    std::string_view name,
+    std::string_view text) const
+{
+    std::string const filePath = path(name);
+    MRDOCS_TRY(files::createDirectory(files::getParentDir(filePath)));
+    std::error_code ec;
+    llvm::raw_fd_ostream os(filePath, ec, llvm::sys::fs::OF_None);
+    MRDOCS_CHECK(!ec, formatError(
+        "raw_fd_ostream(\"{}\") returned \"{}\"", filePath, ec));
+    os << text;
+    MRDOCS_CHECK(!os.has_error(), os.error());
+    return {};
+}
+
+Expected<void>
+TestProject::
+addSource(
+    std::string_view name,
+    std::string_view text)
+{
+    MRDOCS_TRY(write(name, text));
+    addSource(name);
+    return {};
+}
+
+void
+TestProject::
+addSource(std::string_view name)
+{
+    sources_.push_back(path(name));
+}
+
+void
+TestProject::
+removeSource(std::string_view name)
+{
+    std::erase(sources_, path(name));
+}
+
+Expected<Config::Settings>
+TestProject::
+settings() const
+{
+    std::string const configPath = path("mrdocs.yml");
+    MRDOCS_TRY(write("mrdocs.yml",
+        "source-root: .\n"
+        "compilation-database: compile_commands.json\n"
+        "multipage: false\n"
+        "system-includes:\n"
+        "  - system\n"));
+    ReferenceDirectories dirs;
+    dirs.cwd = path(".");
+    dirs.mrdocsRoot = files::getParentDir(MRDOCS_TEST_FILES_DIR);
+    Config::Settings settings;
+    MRDOCS_TRY(Config::Settings::load_file(settings, configPath, dirs));
+    return settings;
+}
+
+Expected<std::shared_ptr<ConfigImpl const>>
+TestProject::
+config(Config::Settings settings)
+{
+    ReferenceDirectories dirs;
+    dirs.cwd = path(".");
+    dirs.mrdocsRoot = files::getParentDir(MRDOCS_TEST_FILES_DIR);
+    MRDOCS_TRY(settings.normalize(dirs));
+    return ConfigImpl::load(settings, dirs, threadPool_);
+}
+
+Expected<std::unique_ptr<Corpus>>
+TestProject::
+build(Config::Settings settings)
+{
+    MRDOCS_TRY(files::createDirectory(path("include")));
+    MRDOCS_TRY(files::createDirectory(path("system")));
+
+    // Compilation database
+    std::string const compileCommandsPath = path("compile_commands.json");
+    {
+        std::string text;
+        llvm::raw_string_ostream os(text);
+        llvm::json::OStream J(os, 2);
+        J.array([&]
+        {
+            for (std::string const& source : sources_)
+            {
+                J.object([&]
+                {
+                    J.attribute("directory", path("."));
+                    J.attribute("file", source);
+                    J.attributeArray("arguments", [&]
+                    {
+                        J.value("clang++");
+                        J.value("-std=c++20");
+                        J.value("-I" + path("include"));
+                        J.value("-c");
+                        J.value(source);
+                    });
+                });
+            }
+        });
+        os.flush();
+        MRDOCS_TRY(write("compile_commands.json", text));
+    }
+
+    MRDOCS_TRY(
+        std::shared_ptr<ConfigImpl const> config,
+        this->config(std::move(settings)));
+
+    std::string errorMessage;
+    std::unique_ptr<tooling::JSONCompilationDatabase> jsonDatabase =
+        tooling::JSONCompilationDatabase::loadFromFile(
+            compileCommandsPath,
+            errorMessage,
+            tooling::JSONCommandLineSyntax::AutoDetect);
+    MRDOCS_CHECK(jsonDatabase, formatError(
+        "Failed to load compilation database: {}", errorMessage));
+    std::unordered_map<std::string, std::vector<std::string>> defaultIncludePaths;
+    MrDocsCompilationDatabase compilations(
+        path("."), *jsonDatabase, config, defaultIncludePaths);
+    return CorpusImpl::build(config, compilations);
+}
+
+Expected<std::unique_ptr<Corpus>>
+TestProject::
+build()
+{
+    MRDOCS_TRY(Config::Settings settings, this->settings());
+    return build(std::move(settings));
+}
+
+Expected<std::string>
+generateString(
+    Corpus const& corpus,
+    std::string_view generator)
+{
+    Generator const* gen = getGenerators().find(generator);
+    MRDOCS_CHECK(gen, formatError(
+        "the Generator \"{}\" was not found", generator));
+    std::string result;
+    MRDOCS_TRY(gen->buildOneString(result, corpus));
+    return result;
+}
+
+} // mrdocs
+} // clang
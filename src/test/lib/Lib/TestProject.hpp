@@ -0,0 +1,141 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#ifndef MRDOCS_TEST_LIB_LIB_TESTPROJECT_HPP
+#define MRDOCS_TEST_LIB_LIB_TESTPROJECT_HPP
+
+#include "lib/Lib/ConfigImpl.hpp"
+#include "lib/Support/Path.hpp"
+#include <mrdocs/Config.hpp>
+#include <mrdocs/Corpus.hpp>
+#include <mrdocs/Support/Error.hpp>
+#include <mrdocs/Support/ThreadPool.hpp>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+/** A small C++ project extracted by the unit tests.
+
+    The files of the project are written to a
+    temporary directory, which is removed by the
+    destructor. The translation units are compiled
+    with the `include` directory of the project as
+    an include path, and the `system` directory as
+    a system include path.
+*/
+class TestProject
+{
+    ScopedTempDirectory dir_;
+    std::vector<std::string> sources_;
+    ThreadPool threadPool_;
+
+public:
+    /** Constructor.
+
+        @param prefix The prefix of the name
+        of the temporary directory.
+        @param concurrency The number of threads
+        extracting the translation units. With a
+        single thread, they are extracted in order.
+    */
+    explicit
+    TestProject(
+        llvm::StringRef prefix,
+        unsigned concurrency = 2);
+
+    /** Return true if the directory was created.
+    */
+    explicit
+    operator bool() const noexcept
+    {
+        return static_cast<bool>(dir_);
+    }
+
+    /** Return the absolute path of a file of the project.
+    */
+    std::string
+    path(std::string_view name) const;
+
+    /** Write a file of the project.
+
+        The parent directories are
+        created if needed.
+    */
+    Expected<void>
+    write(
+        std::string_view name,
+        std::string_view text) const;
+
+    /** Write a translation unit of the project.
+    */
+    Expected<void>
+    addSource(
+        std::string_view name,
+        std::string_view text);
+
+    /** Add an existing file as a translation unit.
+    */
+    void
+    addSource(std::string_view name);
+
+    /** Remove a translation unit from the project.
+
+        The file is kept, but it is not part
+        of the next compilation database.
+    */
+    void
+    removeSource(std::string_view name);
+
+    /** Return the settings of the project.
+
+        The settings are not normalized, so
+        they can be changed before building
+        the corpus.
+    */
+    Expected<Config::Settings>
+    settings() const;
+
+    /** Return the configuration of the project.
+
+        @param settings The settings, which
+        are normalized by this function.
+    */
+    Expected<std::shared_ptr<ConfigImpl const>>
+    config(Config::Settings settings);
+
+    /** Extract the project.
+
+        The compilation database is written
+        with the current translation units.
+    */
+    Expected<std::unique_ptr<Corpus>>
+    build(Config::Settings settings);
+
+    /** Extract the project with its default settings.
+    */
+    Expected<std::unique_ptr<Corpus>>
+    build();
+};
+
+/** Return the single-page documentation of a corpus.
+*/
+Expected<std::string>
+generateString(
+    Corpus const& corpus,
+    std::string_view generator = "xml");
+
+} // mrdocs
+} // clang
+
+#endif
@@ -0,0 +1,112 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Lib/TranslationUnitSchedule.hpp"
+#include "lib/Support/Path.hpp"
+#include <test_suite/test_suite.hpp>
+#include <mrdocs/Support/Path.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+struct TranslationUnitSchedule_test
+{
+    using clock_type = TranslationUnitSchedule::clock_type;
+
+    static
+    std::string
+    writeFile(
+        std::string_view dir,
+        std::string_view name,
+        std::size_t size)
+    {
+        std::string path = files::appendPath(dir, name);
+        std::ofstream(path) << std::string(size, 'x');
+        return path;
+    }
+
+    void
+    run()
+    {
+        ScopedTempDirectory dir("schedule");
+        BOOST_TEST(dir);
+        if (!dir)
+        {
+            return;
+        }
+        std::string const small = writeFile(dir.path(), "small.cpp", 10);
+        std::string const large = writeFile(dir.path(), "large.cpp", 1000);
+        std::string const medium = writeFile(dir.path(), "medium.cpp", 100);
+        std::string const durations = files::appendPath(dir.path(), "durations.json");
+
+        // Without durations, larger files come first
+        {
+            TranslationUnitSchedule schedule(durations);
+            std::vector<std::string> files = { small, large, medium };
+            schedule.order(files);
+            BOOST_TEST(files == std::vector<std::string>({ large, medium, small }));
+            BOOST_TEST_NOT(schedule.last());
+
+            // The small file took the longest
+            auto const t0 = clock_type::now();
+            schedule.record(small, t0, t0 + std::chrono::seconds(30));
+            schedule.record(large, t0, t0 + std::chrono::seconds(20));
+            auto last = schedule.last();
+            BOOST_TEST(last);
+            if (last)
+            {
+                BOOST_TEST(last->Path == small);
+                BOOST_TEST(last->Duration == std::chrono::seconds(30));
+            }
+            BOOST_TEST(schedule.save());
+        }
+
+        // The recorded durations take precedence, and the medium
+        // file is estimated with the rate of the known files
+        {
+            TranslationUnitSchedule schedule(durations);
+            std::vector<std::string> files = { large, medium, small };
+            schedule.order(files);
+            BOOST_TEST(files == std::vector<std::string>({ small, large, medium }));
+        }
+
+        // Durations which were not recorded again are preserved
+        {
+            TranslationUnitSchedule schedule(durations);
+            auto const t0 = clock_type::now();
+            schedule.record(large, t0, t0 + std::chrono::seconds(40));
+            BOOST_TEST(schedule.save());
+        }
+        {
+            TranslationUnitSchedule schedule(durations);
+            std::vector<std::string> files = { small, medium, large };
+            schedule.order(files);
+            BOOST_TEST(files == std::vector<std::string>({ large, small, medium }));
+        }
+
+        // Without a file, nothing is stored
+        {
+            TranslationUnitSchedule schedule("");
+            auto const t0 = clock_type::now();
+            schedule.record(small, t0, t0 + std::chrono::seconds(1));
+            BOOST_TEST(schedule.save());
+        }
+    }
+};
+
+TEST_SUITE(
+    TranslationUnitSchedule_test,
+    "clang.mrdocs.TranslationUnitSchedule");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,342 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "test/lib/Lib/TestProject.hpp"
+#include <mrdocs/Metadata/DomCorpus.hpp>
+#include <test_suite/test_suite.hpp>
+#include <fmt/format.h>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+// The cache is divided in 64 shards by the hash
+// of the symbol ID, and each shard retains its
+// share of the dom-cache-size most recently used
+// symbols, rounded up
+constexpr std::size_t shardCount = 64;
+
+std::size_t
+shardOf(SymbolID const& id)
+{
+    return std::hash<SymbolID>()(id) % shardCount;
+}
+
+} // (anon)
+
+struct DomCorpus_test
+{
+    TestProject project_{"dom-corpus"};
+
+    std::unique_ptr<Corpus>
+    build(std::size_t domCacheSize)
+    {
+        auto settings = project_.settings();
+        BOOST_TEST(settings);
+        if (!settings)
+        {
+            return nullptr;
+        }
+        settings->domCacheSize = domCacheSize;
+        auto corpus = project_.build(*settings);
+        BOOST_TEST(corpus);
+        if (!corpus)
+        {
+            return nullptr;
+        }
+        return std::move(*corpus);
+    }
+
+    // Return the change of the statistics
+    // while a function runs
+    template <class F>
+    static
+    DomCorpus::CacheStats
+    delta(DomCorpus const& dom, F const& f)
+    {
+        DomCorpus::CacheStats const before = dom.cacheStats();
+        f();
+        DomCorpus::CacheStats const after = dom.cacheStats();
+        return {
+            after.hits - before.hits,
+            after.misses - before.misses,
+            after.rebuilds - before.rebuilds };
+    }
+
+    static
+    bool
+    isHit(DomCorpus const& dom, SymbolID const& id)
+    {
+        auto const d = delta(dom, [&]{ dom.get(id); });
+        return d.hits == 1 && d.misses == 0 && d.rebuilds == 0;
+    }
+
+    static
+    bool
+    isMiss(DomCorpus const& dom, SymbolID const& id)
+    {
+        auto const d = delta(dom, [&]{ dom.get(id); });
+        return d.hits == 0 && d.misses == 1 && d.rebuilds == 0;
+    }
+
+    static
+    bool
+    isRebuild(DomCorpus const& dom, SymbolID const& id)
+    {
+        auto const d = delta(dom, [&]{ dom.get(id); });
+        return d.hits == 0 && d.misses == 0 && d.rebuilds == 1;
+    }
+
+    // The functions of the project, and the namespace
+    struct Symbols
+    {
+        std::vector<SymbolID> functions;
+        SymbolID ns = SymbolID::invalid;
+    };
+
+    static
+    Symbols
+    symbols(Corpus const& corpus)
+    {
+        Symbols result;
+        for (Info const& I : corpus)
+        {
+            if (I.isFunction())
+            {
+                result.functions.push_back(I.id);
+            }
+            else if (I.isNamespace() && I.Name == "ns")
+            {
+                result.ns = I.id;
+            }
+        }
+        return result;
+    }
+
+    void
+    testEviction()
+    {
+        // One symbol per shard
+        auto corpus = build(shardCount);
+        if (!corpus)
+        {
+            return;
+        }
+        Symbols const s = symbols(*corpus);
+        BOOST_TEST(s.functions.size() > shardCount);
+
+        // Two functions in the same shard,
+        // and one in another shard
+        std::unordered_map<std::size_t, SymbolID> byShard;
+        SymbolID a = SymbolID::invalid;
+        SymbolID b = SymbolID::invalid;
+        for (SymbolID const& id : s.functions)
+        {
+            auto [it, inserted] = byShard.emplace(shardOf(id), id);
+            if (!inserted)
+            {
+                a = it->second;
+                b = id;
+                break;
+            }
+        }
+        BOOST_TEST(a);
+        BOOST_TEST(b);
+        SymbolID c = SymbolID::invalid;
+        for (SymbolID const& id : s.functions)
+        {
+            if (shardOf(id) != shardOf(a))
+            {
+                c = id;
+                break;
+            }
+        }
+        BOOST_TEST(c);
+        if (!a || !b || !c)
+        {
+            return;
+        }
+
+        DomCorpus dom(*corpus);
+        BOOST_TEST(isMiss(dom, a));
+        BOOST_TEST(isHit(dom, a));
+        BOOST_TEST(isMiss(dom, c));
+
+        // b releases a, which is created again
+        // and releases b
+        BOOST_TEST(isMiss(dom, b));
+        BOOST_TEST(isRebuild(dom, a));
+        BOOST_TEST(isRebuild(dom, b));
+        BOOST_TEST(isHit(dom, b));
+
+        // the other shard kept its symbol
+        BOOST_TEST(isHit(dom, c));
+
+        // a referenced object is found after
+        // it is released from the cache
+        {
+            dom::Value const held = dom.get(a);
+            BOOST_TEST(held.isObject());
+            BOOST_TEST(isRebuild(dom, b));
+            BOOST_TEST(isHit(dom, a));
+        }
+        BOOST_TEST(isHit(dom, a));
+        BOOST_TEST(isRebuild(dom, b));
+
+        // namespaces are retained
+        BOOST_TEST(s.ns);
+        dom.get(s.ns);
+        for (SymbolID const& id : s.functions)
+        {
+            dom.get(id);
+        }
+        BOOST_TEST(isHit(dom, s.ns));
+    }
+
+    void
+    testCapacity()
+    {
+        // Every symbol is retained
+        auto corpus = build(16384);
+        if (!corpus)
+        {
+            return;
+        }
+        Symbols const s = symbols(*corpus);
+        DomCorpus dom(*corpus);
+        auto const first = delta(dom, [&]
+        {
+            for (SymbolID const& id : s.functions)
+            {
+                dom.get(id);
+            }
+        });
+        BOOST_TEST(first.misses == s.functions.size());
+        BOOST_TEST(first.hits == 0);
+        BOOST_TEST(first.rebuilds == 0);
+        auto const second = delta(dom, [&]
+        {
+            for (SymbolID const& id : s.functions)
+            {
+                dom.get(id);
+            }
+        });
+        BOOST_TEST(second.hits == s.functions.size());
+        BOOST_TEST(second.misses == 0);
+        BOOST_TEST(second.rebuilds == 0);
+    }
+
+    void
+    testNoCache()
+    {
+        // Only referenced objects and
+        // namespaces are kept
+        auto corpus = build(0);
+        if (!corpus)
+        {
+            return;
+        }
+        Symbols const s = symbols(*corpus);
+        BOOST_TEST(!s.functions.empty());
+        BOOST_TEST(s.ns);
+        if (s.functions.empty() || !s.ns)
+        {
+            return;
+        }
+        SymbolID const id = s.functions.front();
+
+        DomCorpus dom(*corpus);
+        BOOST_TEST(isMiss(dom, id));
+        BOOST_TEST(isRebuild(dom, id));
+        {
+            dom::Value const held = dom.get(id);
+            BOOST_TEST(isHit(dom, id));
+        }
+        BOOST_TEST(isRebuild(dom, id));
+
+        dom.get(s.ns);
+        BOOST_TEST(isHit(dom, s.ns));
+
+        // an invalid ID is not counted
+        auto const invalid = delta(dom, [&]
+        {
+            BOOST_TEST(dom.get(SymbolID::invalid).isNull());
+        });
+        BOOST_TEST(invalid.hits == 0);
+        BOOST_TEST(invalid.misses == 0);
+        BOOST_TEST(invalid.rebuilds == 0);
+    }
+
+    void
+    testStrings()
+    {
+        auto corpus = build(0);
+        if (!corpus)
+        {
+            return;
+        }
+        Symbols const s = symbols(*corpus);
+        if (s.functions.empty())
+        {
+            return;
+        }
+        Info const& I = corpus->get(s.functions.front());
+
+        // Names are interned, so every object built
+        // for the symbol references the same copy
+        DomCorpus dom(*corpus);
+        dom::String const name = dom.get(I.id).get("name").getString();
+        BOOST_TEST(name == I.Name);
+        BOOST_TEST(name.data() == dom.intern(I.Name).data());
+        dom::String const rebuilt = dom.get(I.id).get("name").getString();
+        BOOST_TEST(rebuilt.data() == name.data());
+    }
+
+    void
+    run()
+    {
+        BOOST_TEST(project_);
+        if (!project_)
+        {
+            return;
+        }
+
+        // More functions than shards, so
+        // some shards have several functions
+        std::string header = "namespace ns {\n";
+        for (std::size_t i = 0; i < 2 * shardCount; ++i)
+        {
+            header += fmt::format(
+                "/// Function {0}\n"
+                "void f{0}();\n", i);
+        }
+        header += "} // ns\n";
+        BOOST_TEST(project_.write("include/lib.hpp", header));
+        BOOST_TEST(project_.addSource("src/lib.cpp",
+            "#include <lib.hpp>\n"));
+
+        testEviction();
+        testCapacity();
+        testNoCache();
+        testStrings();
+    }
+};
+
+TEST_SUITE(
+    DomCorpus_test,
+    "clang.mrdocs.Metadata.DomCorpus");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,156 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Metadata/Reduce.hpp"
+#include <mrdocs/Metadata/Namespace.hpp>
+#include <mrdocs/Metadata/Record.hpp>
+#include <test_suite/test_suite.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+SymbolID
+makeID(std::uint32_t n)
+{
+    // Spread the bits of n over the ID,
+    // like the hash of a USR
+    std::uint8_t data[20] = {};
+    std::uint64_t h = n * 0x9E3779B97F4A7C15ull + 1;
+    std::memcpy(data, &h, sizeof(h));
+    std::memcpy(data + 8, &n, sizeof(n));
+    return SymbolID(data);
+}
+
+// The members of a namespace as seen by
+// a translation unit, which sees the
+// members in the range [first, last)
+NamespaceInfo
+makeNamespace(std::uint32_t first, std::uint32_t last)
+{
+    NamespaceInfo I(makeID(0));
+    for (std::uint32_t n = first; n < last; ++n)
+    {
+        I.Members.push_back(makeID(n + 1));
+    }
+    return I;
+}
+
+} // (anon)
+
+struct Reduce_test
+{
+    void
+    testMembers()
+    {
+        // Small lists
+        {
+            NamespaceInfo I = makeNamespace(0, 4);
+            merge(I, makeNamespace(2, 8));
+            merge(I, makeNamespace(0, 1));
+            BOOST_TEST(I.Members.size() == 8);
+            for (std::uint32_t n = 0; n < 8; ++n)
+            {
+                BOOST_TEST(I.Members[n] == makeID(n + 1));
+            }
+        }
+
+        // Large lists keep the first-seen order
+        {
+            NamespaceInfo I = makeNamespace(1000, 3000);
+            merge(I, makeNamespace(0, 2000));
+            merge(I, makeNamespace(2500, 4000));
+            BOOST_TEST(I.Members.size() == 4000);
+            std::uint32_t i = 0;
+            for (std::uint32_t n = 1000; n < 3000; ++n)
+            {
+                BOOST_TEST(I.Members[i++] == makeID(n + 1));
+            }
+            for (std::uint32_t n = 0; n < 1000; ++n)
+            {
+                BOOST_TEST(I.Members[i++] == makeID(n + 1));
+            }
+            for (std::uint32_t n = 3000; n < 4000; ++n)
+            {
+                BOOST_TEST(I.Members[i++] == makeID(n + 1));
+            }
+        }
+    }
+
+    void
+    testLocations()
+    {
+        // Files with the same name in different
+        // directories are different files
+        Location const a0("/a/x.hpp", "x.hpp", 3);
+        Location const b0("/b/x.hpp", "x.hpp", 3);
+        Location const a1("/a/x.hpp", "x.hpp", 7);
+
+        RecordInfo I(makeID(1));
+        I.Loc = { a0, a1, b0 };
+        RecordInfo Other(makeID(1));
+        Other.Loc = { b0, a0, b0, a1 };
+        merge(I, std::move(Other));
+        BOOST_TEST(I.Loc.size() == 3);
+        BOOST_TEST(I.Loc[0].LineNumber == 3);
+        BOOST_TEST(I.Loc[1].LineNumber == 3);
+        BOOST_TEST(I.Loc[0].FileId != I.Loc[1].FileId);
+        BOOST_TEST(I.Loc[2].FileId == a1.FileId);
+        BOOST_TEST(I.Loc[2].LineNumber == 7);
+    }
+
+    void
+    benchMembers()
+    {
+        // Merge a namespace with 50k members as
+        // seen from 100 translation units, each
+        // of which sees most of the members
+        using clock_type = std::chrono::steady_clock;
+        constexpr std::uint32_t members = 50000;
+        constexpr std::uint32_t units = 100;
+        NamespaceInfo I(makeID(0));
+        auto const start = clock_type::now();
+        for (std::uint32_t u = 0; u < units; ++u)
+        {
+            std::uint32_t const first = u * 100;
+            merge(I, makeNamespace(first, members - first / 2));
+        }
+        auto const elapsed = std::chrono::duration_cast<
+            std::chrono::milliseconds>(clock_type::now() - start);
+        BOOST_TEST(I.Members.size() == members);
+        std::unordered_set<SymbolID> const unique(
+            I.Members.begin(), I.Members.end());
+        BOOST_TEST(unique.size() == members);
+        test_suite::log <<
+            "Merged " << units << " namespaces with " <<
+            members << " members in " << elapsed.count() << "ms\n";
+    }
+
+    void
+    run()
+    {
+        testMembers();
+        testLocations();
+        benchMembers();
+    }
+};
+
+TEST_SUITE(
+    Reduce_test,
+    "clang.mrdocs.Reduce");
+
+} // mrdocs
+} // clang
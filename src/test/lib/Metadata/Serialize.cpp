@@ -0,0 +1,405 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Metadata/Serialize.hpp"
+#include "test/lib/Lib/TestProject.hpp"
+#include <mrdocs/Metadata.hpp>
+#include <test_suite/test_suite.hpp>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+std::string
+encode(Info const& I)
+{
+    std::string data;
+    BinaryWriter(data).writeInfo(I);
+    return data;
+}
+
+} // (anon)
+
+struct Serialize_test
+{
+    // An Info read back is written as the same
+    // bytes, and it keeps its kind, ID, and javadoc
+    void
+    testRoundTrip(Info const& I)
+    {
+        std::string const data = encode(I);
+        BinaryReader r(data);
+        std::unique_ptr<Info> read;
+        try
+        {
+            read = r.readInfo();
+        }
+        catch (Exception const&)
+        {
+            BOOST_TEST(false);
+            return;
+        }
+        BOOST_TEST(r.empty());
+        BOOST_TEST(read->Kind == I.Kind);
+        BOOST_TEST(read->id == I.id);
+        BOOST_TEST(read->Name == I.Name);
+        BOOST_TEST((!read->javadoc == !I.javadoc));
+        if (read->javadoc && I.javadoc)
+        {
+            BOOST_TEST(*read->javadoc == *I.javadoc);
+        }
+        BOOST_TEST(encode(*read) == data);
+
+        // Every prefix of the data is truncated
+        for (std::size_t n = 0; n < data.size(); n += 1 + n / 8)
+        {
+            BinaryReader truncated(std::string_view(data).substr(0, n));
+            bool threw = false;
+            try
+            {
+                truncated.readInfo();
+            }
+            catch (Exception const&)
+            {
+                threw = true;
+            }
+            BOOST_TEST(threw);
+        }
+    }
+
+    void
+    testCorpus()
+    {
+        TestProject project("serialize");
+        BOOST_TEST(project);
+        if (!project)
+        {
+            return;
+        }
+
+        // The declarations cover every kind of symbol the
+        // extractor creates, the kinds of types, names,
+        // template arguments and parameters, and the
+        // kinds of javadoc nodes
+        BOOST_TEST(project.write("include/lib.hpp",
+            "namespace ns {\n"
+            "\n"
+            "template<class T> struct C2 {};\n"
+            "\n"
+            "/** A class template\n"
+            "\n"
+            "    # Heading\n"
+            "\n"
+            "    Text with *emphasis*, `code`, a link\n"
+            "    <a href=\"https://cppalliance.org\">here</a>,\n"
+            "    and a reference to @ref ns::f.\n"
+            "\n"
+            "    @note An admonition\n"
+            "\n"
+            "    @code\n"
+            "    C<int> c;\n"
+            "    @endcode\n"
+            "\n"
+            "    @li First item\n"
+            "    @li Second item\n"
+            "\n"
+            "    @tparam T A type parameter\n"
+            "    @tparam N A non-type parameter\n"
+            "    @tparam TT A template template parameter\n"
+            "    @see ns::f\n"
+            "*/\n"
+            "template<class T, int N = 2, template<class> class TT = C2>\n"
+            "struct C;\n"
+            "\n"
+            "template<class T, int N, template<class> class TT>\n"
+            "struct C : C2<T>\n"
+            "{\n"
+            "    /// A field\n"
+            "    mutable int field : 3;\n"
+            "    /// A member pointer\n"
+            "    int C2<T>::* member;\n"
+            "    /// An array of function pointers\n"
+            "    void (*callbacks[N])(T&&, ...) noexcept;\n"
+            "\n"
+            "    friend struct C2<T>;\n"
+            "    explicit(N > 1) C(T const&);\n"
+            "    auto g() const& -> decltype(field);\n"
+            "};\n"
+            "\n"
+            "template<class T> C(T) -> C<T>;\n"
+            "\n"
+            "/** A function\n"
+            "\n"
+            "    @param[in] x The parameter\n"
+            "    @return A value\n"
+            "    @throws int An exception\n"
+            "    @pre A precondition\n"
+            "    @post A postcondition\n"
+            "*/\n"
+            "[[nodiscard]] constexpr int f(int x = 1) noexcept(false);\n"
+            "\n"
+            "/// @copydoc f\n"
+            "int f2(int x);\n"
+            "\n"
+            "/// An explicit specialization\n"
+            "template<> struct C<char, 1, C2> {};\n"
+            "\n"
+            "/// A scoped enumeration\n"
+            "enum class E : unsigned char { a = 1, b };\n"
+            "\n"
+            "/// An alias template\n"
+            "template<class... Ts> using A = C2<void(Ts...)>;\n"
+            "/// A typedef\n"
+            "typedef int* P;\n"
+            "/// A variable template\n"
+            "template<class T> constexpr T v = T(3);\n"
+            "/// A thread local variable\n"
+            "inline thread_local int t = 0;\n"
+            "\n"
+            "/// A concept\n"
+            "template<class T> concept K = sizeof(T) > 1;\n"
+            "/// A constrained function\n"
+            "template<K T> void h(K auto&& u) requires (sizeof(T) > 2);\n"
+            "\n"
+            "inline namespace in {}\n"
+            "namespace { int anon; }\n"
+            "} // ns\n"
+            "\n"
+            "/// A namespace alias\n"
+            "namespace na = ns;\n"
+            "/// A using declaration\n"
+            "using ns::f;\n"));
+        BOOST_TEST(project.addSource("src/lib.cpp",
+            "#include <lib.hpp>\n"));
+
+        auto settings = project.settings();
+        BOOST_TEST(settings);
+        if (!settings)
+        {
+            return;
+        }
+        settings->anonymousNamespaces = true;
+        auto corpus = project.build(*settings);
+        BOOST_TEST(corpus);
+        if (!corpus)
+        {
+            return;
+        }
+
+        std::set<InfoKind> kinds;
+        for (Info const& I : **corpus)
+        {
+            kinds.insert(I.Kind);
+            testRoundTrip(I);
+        }
+
+        // Specializations are not created by the
+        // extractor, so they are tested separately
+        #define INFO(Type) \
+            if (InfoKind::Type != InfoKind::Specialization) \
+            { \
+                BOOST_TEST(kinds.contains(InfoKind::Type)); \
+            }
+        #include <mrdocs/Metadata/InfoNodesPascal.inc>
+    }
+
+    void
+    testSpecialization()
+    {
+        SymbolID const id("0123456789abcdefghij");
+        SymbolID const primary("abcdefghij0123456789");
+        SpecializationInfo I(id);
+        I.Name = "S";
+        I.Primary = primary;
+        I.Members.push_back(primary);
+        I.Lookups["S"].push_back(primary);
+
+        auto type = std::make_unique<NamedTypeInfo>();
+        type->Name = std::make_unique<SpecializationNameInfo>();
+        type->Name->Name = "C2";
+        type->Name->id = primary;
+        auto arg = std::make_unique<TypeTArg>();
+        arg->Type = std::make_unique<NamedTypeInfo>();
+        static_cast<NamedTypeInfo&>(*arg->Type).Name =
+            std::make_unique<NameInfo>();
+        static_cast<NamedTypeInfo&>(*arg->Type).Name->Name = "int";
+        static_cast<SpecializationNameInfo&>(*type->Name)
+            .TemplateArgs.push_back(std::move(arg));
+
+        auto typeArg = std::make_unique<TypeTArg>();
+        typeArg->Type = std::move(type);
+        typeArg->IsPackExpansion = true;
+        I.Args.push_back(std::move(typeArg));
+        auto nonTypeArg = std::make_unique<NonTypeTArg>();
+        nonTypeArg->Value.Written = "42";
+        I.Args.push_back(std::move(nonTypeArg));
+        auto templateArg = std::make_unique<TemplateTArg>();
+        templateArg->Name = "C2";
+        templateArg->Template = primary;
+        I.Args.push_back(std::move(templateArg));
+
+        testRoundTrip(I);
+
+        // Lookups with several entries are
+        // written in the same order
+        for (int i = 0; i < 32; ++i)
+        {
+            I.Lookups["name" + std::to_string(i)].push_back(id);
+        }
+        std::string const data = encode(I);
+        std::unique_ptr<Info> read = BinaryReader(data).readInfo();
+        BOOST_TEST(static_cast<SpecializationInfo&>(*read).Lookups == I.Lookups);
+        BOOST_TEST(encode(*read) == data);
+    }
+
+    void
+    testInfoSet()
+    {
+        InfoSet info;
+        for (char c = 'a'; c <= 'h'; ++c)
+        {
+            std::string bytes(20, c);
+            auto I = std::make_unique<NamespaceInfo>(
+                SymbolID(bytes.data()));
+            I->Name = std::string(1, c);
+            info.emplace(std::move(I));
+        }
+
+        std::string data;
+        BinaryWriter(data).writeInfoSet(info);
+        BinaryReader r(data);
+        InfoSet const read = r.readInfoSet();
+        BOOST_TEST(r.empty());
+        BOOST_TEST(read.size() == info.size());
+        for (auto const& I : info)
+        {
+            auto it = read.find(I->id);
+            BOOST_TEST(it != read.end());
+            if (it != read.end())
+            {
+                BOOST_TEST((*it)->Name == I->Name);
+                BOOST_TEST((*it)->isNamespace());
+            }
+        }
+
+        // A set with the same symbol twice is malformed
+        std::string twice;
+        BinaryWriter w(twice);
+        w.writeUInt(2);
+        w.writeInfo(**info.begin());
+        w.writeInfo(**info.begin());
+        bool threw = false;
+        try
+        {
+            BinaryReader(twice).readInfoSet();
+        }
+        catch (Exception const&)
+        {
+            threw = true;
+        }
+        BOOST_TEST(threw);
+    }
+
+    void
+    testMalformed()
+    {
+        auto readInfoThrows = [](std::string const& data)
+        {
+            try
+            {
+                BinaryReader(data).readInfo();
+            }
+            catch (Exception const&)
+            {
+                return true;
+            }
+            return false;
+        };
+
+        // unknown info kind
+        {
+            std::string data;
+            BinaryWriter w(data);
+            w.writeUInt(1000);
+            w.writeSymbolID(SymbolID::global);
+            BOOST_TEST(readInfoThrows(data));
+        }
+
+        // integer longer than 64 bits
+        {
+            std::string data(11, '\xff');
+            BOOST_TEST(readInfoThrows(data));
+        }
+
+        // invalid enumerator
+        {
+            NamespaceInfo I(SymbolID::global);
+            std::string data = encode(I);
+            BOOST_TEST(!readInfoThrows(data));
+            // kind, id, empty name, access
+            std::size_t const access = 1 + SymbolID::global.size() + 1;
+            data[access] = 0x7f;
+            BOOST_TEST(readInfoThrows(data));
+        }
+
+        // counts larger than the data are reported
+        // before any memory is reserved
+        {
+            std::string data;
+            BinaryWriter w(data);
+            w.writeUInt(std::uint64_t(1) << 62);
+            bool threw = false;
+            try
+            {
+                BinaryReader(data).readInfoSet();
+            }
+            catch (Exception const&)
+            {
+                threw = true;
+            }
+            BOOST_TEST(threw);
+        }
+        {
+            NamespaceInfo I(SymbolID::global);
+            I.Members.push_back(SymbolID::global);
+            std::string const data = encode(I);
+            // kind, id, empty name, access, extraction,
+            // parent, no javadoc, and the count of members
+            std::size_t const members = 1 + 20 + 1 + 1 + 1 + 20 + 1;
+            BOOST_TEST((data[members] == 1));
+            std::string patched;
+            BinaryWriter w(patched);
+            patched.append(data, 0, members);
+            w.writeUInt(std::uint64_t(1) << 62);
+            patched.append(data, members + 1);
+            BOOST_TEST(readInfoThrows(patched));
+        }
+    }
+
+    void
+    run()
+    {
+        testCorpus();
+        testSpecialization();
+        testInfoSet();
+        testMalformed();
+    }
+};
+
+TEST_SUITE(
+    Serialize_test,
+    "clang.mrdocs.Metadata.Serialize");
+
+} // mrdocs
+} // clang
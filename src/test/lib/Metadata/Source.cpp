@@ -0,0 +1,125 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include <mrdocs/Metadata/Source.hpp>
+#include <test_suite/test_suite.hpp>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+struct Source_test
+{
+    void
+    testFileTable()
+    {
+        FileTable& table = FileTable::instance();
+
+        // no file
+        {
+            BOOST_TEST(table.add("", "", FileKind::Source) == 0);
+            SourceFile const file = table.get(0);
+            BOOST_TEST(file.Path.empty());
+            BOOST_TEST(file.Filename.empty());
+        }
+
+        // files are identified by their path, name, and kind
+        {
+            std::size_t const size = table.size();
+            std::uint32_t const id = table.add(
+                "/src/include/a.hpp", "a.hpp", FileKind::Source);
+            BOOST_TEST(id != 0);
+            BOOST_TEST(table.add(
+                "/src/include/a.hpp", "a.hpp", FileKind::Source) == id);
+            BOOST_TEST(table.size() == size + 1);
+            SourceFile const file = table.get(id);
+            BOOST_TEST(file.Path == "/src/include/a.hpp");
+            BOOST_TEST(file.Filename == "a.hpp");
+            BOOST_TEST(file.Kind == FileKind::Source);
+
+            // another configuration with another source root
+            std::uint32_t const other = table.add(
+                "/src/include/a.hpp", "include/a.hpp", FileKind::Other);
+            BOOST_TEST(other != id);
+            BOOST_TEST(table.size() == size + 2);
+            BOOST_TEST(table.get(other).Filename == "include/a.hpp");
+            BOOST_TEST(table.get(other).Kind == FileKind::Other);
+            BOOST_TEST(table.get(id).Filename == "a.hpp");
+        }
+
+        // files added concurrently
+        {
+            std::vector<std::thread> threads;
+            std::vector<std::vector<std::uint32_t>> ids(4);
+            for (std::size_t t = 0; t < ids.size(); ++t)
+            {
+                threads.emplace_back([&ids, &table, t]
+                {
+                    for (int i = 0; i < 5000; ++i)
+                    {
+                        std::string const name =
+                            "f" + std::to_string(i) + ".hpp";
+                        ids[t].push_back(table.add(
+                            "/usr/include/" + name, name,
+                            FileKind::System));
+                    }
+                });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            for (std::size_t t = 1; t < ids.size(); ++t)
+            {
+                BOOST_TEST(ids[t] == ids[0]);
+            }
+            SourceFile const file = table.get(ids[0][4321]);
+            BOOST_TEST(file.Path == "/usr/include/f4321.hpp");
+            BOOST_TEST(file.Filename == "f4321.hpp");
+            BOOST_TEST(file.Kind == FileKind::System);
+        }
+    }
+
+    void
+    testLocation()
+    {
+        Location const loc(
+            "/src/include/c.hpp", "c.hpp", 12,
+            FileKind::Other, true);
+        BOOST_TEST(loc.path() == "/src/include/c.hpp");
+        BOOST_TEST(loc.filename() == "c.hpp");
+        BOOST_TEST(loc.kind() == FileKind::Other);
+        BOOST_TEST(loc.LineNumber == 12);
+        BOOST_TEST(loc.Documented);
+        BOOST_TEST(Location(loc.FileId, 3).filename() == "c.hpp");
+
+        OptionalLocation opt;
+        BOOST_TEST_NOT(opt.has_value());
+        opt.emplace(loc.FileId, 1);
+        BOOST_TEST(opt.has_value());
+    }
+
+    void
+    run()
+    {
+        testFileTable();
+        testLocation();
+    }
+};
+
+TEST_SUITE(
+    Source_test,
+    "clang.mrdocs.Source");
+
+} // mrdocs
+} // clang
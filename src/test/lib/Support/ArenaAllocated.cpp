@@ -0,0 +1,199 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include <mrdocs/Support/ArenaAllocated.hpp>
+#include <test_suite/test_suite.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+struct Base : ArenaAllocated
+{
+    int value = 0;
+
+    explicit Base(int v) : value(v) {}
+
+    virtual ~Base() = default;
+};
+
+template <std::size_t N>
+struct Derived : Base
+{
+    char data[N];
+    std::string str;
+
+    explicit Derived(int v)
+        : Base(v)
+        , str(std::to_string(v))
+    {
+        data[0] = 'x';
+        data[N - 1] = 'y';
+    }
+};
+
+bool
+isAligned(void const* p)
+{
+    return reinterpret_cast<std::uintptr_t>(p) %
+        __STDCPP_DEFAULT_NEW_ALIGNMENT__ == 0;
+}
+
+// Whether b was allocated right after a
+template <class T>
+bool
+isNext(void const* a, void const* b)
+{
+    constexpr std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+    constexpr std::size_t n =
+        (sizeof(T) + alignment - 1) / alignment * alignment + alignment;
+    return static_cast<char const*>(b) - static_cast<char const*>(a) == n;
+}
+
+std::vector<std::unique_ptr<Base>>
+makeObjects(int first, int last)
+{
+    std::vector<std::unique_ptr<Base>> objects;
+    for (int i = first; i < last; ++i)
+    {
+        switch (i % 4)
+        {
+        case 0: objects.push_back(std::make_unique<Derived<1>>(i)); break;
+        case 1: objects.push_back(std::make_unique<Derived<100>>(i)); break;
+        case 2: objects.push_back(std::make_unique<Derived<1000>>(i)); break;
+        case 3: objects.push_back(std::make_unique<Derived<5000>>(i)); break;
+        }
+    }
+    return objects;
+}
+
+} // (anon)
+
+struct ArenaAllocated_test
+{
+    void
+    testHeap()
+    {
+        // Without a scope, objects are
+        // allocated from the heap
+        auto objects = makeObjects(0, 1000);
+        for (int i = 0; i < 1000; ++i)
+        {
+            BOOST_TEST(objects[i]->value == i);
+            BOOST_TEST(isAligned(objects[i].get()));
+        }
+    }
+
+    void
+    testScope()
+    {
+        std::vector<std::unique_ptr<Base>> objects;
+        {
+            ArenaScope scope;
+            objects = makeObjects(0, 1000);
+
+            // Small objects are allocated one
+            // after the other
+            auto a = std::make_unique<Derived<24>>(0);
+            auto b = std::make_unique<Derived<24>>(1);
+            BOOST_TEST(isNext<Derived<24>>(a.get(), b.get()));
+        }
+
+        // The objects outlive the scope
+        for (int i = 0; i < 1000; ++i)
+        {
+            BOOST_TEST(objects[i]->value == i);
+            BOOST_TEST(isAligned(objects[i].get()));
+        }
+    }
+
+    void
+    testNested()
+    {
+        ArenaScope outer;
+        auto a = std::make_unique<Derived<24>>(0);
+        {
+            ArenaScope inner;
+            auto b = std::make_unique<Derived<24>>(1);
+            BOOST_TEST(!isNext<Derived<24>>(a.get(), b.get()));
+        }
+
+        // The outer scope is active again
+        auto c = std::make_unique<Derived<24>>(2);
+        BOOST_TEST(isNext<Derived<24>>(a.get(), c.get()));
+    }
+
+    void
+    testThreads()
+    {
+        // Objects are created in the scopes of some
+        // threads and destroyed by other threads,
+        // before and after their scopes ended
+        std::vector<std::unique_ptr<Base>> objects(4000);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&objects, t]
+            {
+                ArenaScope scope;
+                for (int i = t * 1000; i < (t + 1) * 1000; ++i)
+                {
+                    objects[i] = std::make_unique<Derived<24>>(i);
+                }
+                objects[t * 1000].reset();
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        threads.clear();
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&objects, t]
+            {
+                for (int i = t; i < 4000; i += 4)
+                {
+                    if (objects[i])
+                    {
+                        BOOST_TEST(objects[i]->value == i);
+                        objects[i].reset();
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    void
+    run()
+    {
+        testHeap();
+        testScope();
+        testNested();
+        testThreads();
+    }
+};
+
+TEST_SUITE(
+    ArenaAllocated_test,
+    "clang.mrdocs.ArenaAllocated");
+
+} // mrdocs
+} // clang
@@ -0,0 +1,255 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/CharSet.hpp"
+#include "lib/Gen/adoc/AdocEscape.hpp"
+#include <mrdocs/Support/Handlebars.hpp>
+#include <test_suite/test_suite.hpp>
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <utility>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+// The escape functions before they were vectorized,
+// which write one character at a time
+
+void
+referenceHTMLEscape(OutputRef& out, std::string_view str)
+{
+    static constexpr std::pair<char, std::string_view>
+        escapeMap[] = {
+            {'&', "&amp;"},
+            {'<', "&lt;"},
+            {'>', "&gt;"},
+            {'"', "&quot;"},
+            {'\'', "&#x27;"},
+            {'`', "&#x60;"},
+            {'=', "&#x3D;"}
+        };
+    static constexpr auto badChars = std::views::keys(escapeMap);
+    for (auto c : str)
+    {
+        if (auto it = std::ranges::find(badChars, c); it != badChars.end())
+        {
+            out << it.base()->second;
+        }
+        else
+        {
+            out << c;
+        }
+    }
+}
+
+void
+referenceAdocEscape(OutputRef& out, std::string_view str)
+{
+    static constexpr char reserved[] = R"(~^_*`#[]{}<>\|-=&;+:."\'/)";
+    for (char c : str)
+    {
+        if (std::ranges::find(reserved, c) != std::end(reserved))
+        {
+            // The replacement of a single character
+            // does not depend on the search
+            std::string const s = adoc::AdocEscape(std::string_view(&c, 1));
+            out << s;
+        }
+        else
+        {
+            out << c;
+        }
+    }
+}
+
+template <class Escape>
+std::string
+escape(Escape const& fn, std::string_view str, std::size_t indent = 0)
+{
+    std::string res;
+    OutputRef out(res);
+    out.setIndent(indent);
+    fn(out, str);
+    return res;
+}
+
+// A string with the distribution of characters
+// found in documentation
+std::string
+makeText(std::size_t size)
+{
+    static constexpr std::string_view words[] = {
+        "Return", "the", "value", "of", "std::vector<int>", "a",
+        "if", "x == y", "then\n", "\"quoted\"", "it's", "`code`",
+        "a_b", "[link]", "{brace}", "-1", "<b>", "&amp;"
+    };
+    std::string text;
+    std::uint32_t seed = 12345;
+    while (text.size() < size)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        text.append(words[(seed >> 16) % std::size(words)]);
+        text.push_back(' ');
+    }
+    text.resize(size);
+    return text;
+}
+
+char const*
+kernelName(CharSet::Kernel const kernel)
+{
+    switch (kernel)
+    {
+    case CharSet::Kernel::Scalar: return "scalar";
+    case CharSet::Kernel::SSSE3: return "SSSE3";
+    case CharSet::Kernel::AVX2: return "AVX2";
+    case CharSet::Kernel::NEON: return "NEON";
+    }
+    return "";
+}
+
+} // (anon)
+
+struct CharSet_test
+{
+    static constexpr CharSet::Kernel kernels[] = {
+        CharSet::Kernel::Scalar,
+        CharSet::Kernel::SSSE3,
+        CharSet::Kernel::AVX2,
+        CharSet::Kernel::NEON
+    };
+
+    void
+    testFind()
+    {
+        static constexpr std::string_view chars[] = {
+            "", "a", "&<>\"'`=", "~^_*`#[]{}<>\\|-=&;+:.\"'/",
+            std::string_view("\0\x7F", 2), "\x80\xFF"
+        };
+        for (std::string_view const setChars : chars)
+        {
+            CharSet const set(setChars);
+            for (int c = 0; c < 256; ++c)
+            {
+                bool const expected =
+                    setChars.find(static_cast<char>(c)) != std::string_view::npos;
+                if (expected)
+                {
+                    BOOST_TEST(set.contains(static_cast<char>(c)));
+                }
+                else
+                {
+                    BOOST_TEST_NOT(set.contains(static_cast<char>(c)));
+                }
+            }
+
+            // Every kernel, length and position, including
+            // the blocks and the remaining bytes of the kernels
+            for (CharSet::Kernel const kernel : kernels)
+            {
+                if (!CharSet::isSupported(kernel))
+                {
+                    continue;
+                }
+                for (std::size_t size = 0; size < 72; ++size)
+                {
+                    for (std::size_t pos = 0; pos <= size; ++pos)
+                    {
+                        for (int c = 0; c < 256; c += 17)
+                        {
+                            std::string str(size, 'z');
+                            if (pos < size)
+                            {
+                                str[pos] = static_cast<char>(c);
+                            }
+                            std::size_t expected = std::string_view::npos;
+                            for (std::size_t i = 0; i < size; ++i)
+                            {
+                                if (set.contains(str[i]))
+                                {
+                                    expected = i;
+                                    break;
+                                }
+                            }
+                            BOOST_TEST(set.find(str, kernel) == expected);
+                            BOOST_TEST(set.find(str) == expected);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    testKernels()
+    {
+        BOOST_TEST(CharSet::isSupported(CharSet::Kernel::Scalar));
+        for (CharSet::Kernel const kernel : kernels)
+        {
+            // The kernels the CPU does not support
+            // are not tested by this run
+            test_suite::log <<
+                "The " << kernelName(kernel) << " kernel is" <<
+                (CharSet::isSupported(kernel) ? "" : " not") <<
+                " supported\n";
+        }
+        // The kernels of other architectures
+        // are never supported
+#if defined(__x86_64__) || defined(_M_X64)
+        BOOST_TEST_NOT(CharSet::isSupported(CharSet::Kernel::NEON));
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        BOOST_TEST(CharSet::isSupported(CharSet::Kernel::NEON));
+        BOOST_TEST_NOT(CharSet::isSupported(CharSet::Kernel::AVX2));
+#endif
+    }
+
+    void
+    testEscape()
+    {
+        std::string all;
+        for (int c = 0; c < 256; ++c)
+        {
+            all.push_back(static_cast<char>(c));
+        }
+        std::string const text = makeText(4096);
+        for (std::string_view const str :
+            { std::string_view(), std::string_view(all),
+              std::string_view(text), std::string_view("a\n<b>\n\nc\n") })
+        {
+            for (std::size_t indent : { 0, 4 })
+            {
+                BOOST_TEST(
+                    escape(static_cast<void(*)(OutputRef&, std::string_view)>(HTMLEscape), str, indent) ==
+                    escape(referenceHTMLEscape, str, indent));
+                BOOST_TEST(
+                    escape(static_cast<void(*)(OutputRef&, std::string_view)>(adoc::AdocEscape), str, indent) ==
+                    escape(referenceAdocEscape, str, indent));
+            }
+        }
+    }
+
+    void
+    run()
+    {
+        testFind();
+        testKernels();
+        testEscape();
+    }
+};
+
+TEST_SUITE(
+    CharSet_test,
+    "clang.mrdocs.CharSet");
+
+} // mrdocs
+} // clang
@@ -661,6 +661,85 @@ master_test()
         master.logger_error_output_path);
 }
 
+void
+compiled_templates()
+{
+    // The master template renders the same when compiled
+    {
+        HandlebarsTemplate tmpl = Handlebars::compile(master.template_str);
+        BOOST_TEST(tmpl.text() == master.template_str);
+        std::string rendered_text = master.hbs.render(
+            tmpl,
+            master.context,
+            master.options);
+        BOOST_TEST(rendered_text == master.master_file_contents);
+    }
+
+    // Compiled templates are rendered the same as their text
+    {
+        Handlebars hbs;
+        hbs.registerPartial("item", "  {{name}}\n");
+        dom::Object ctx;
+        dom::Array items;
+        for (std::string_view name: {"a", "b", "c"})
+        {
+            dom::Object item;
+            item.set("name", name);
+            items.emplace_back(item);
+        }
+        ctx.set("items", items);
+        ctx.set("flag", true);
+        for (std::string_view templ: {
+            "",
+            "text without tags",
+            "{{",
+            "{{flag",
+            "{{#if flag}}yes{{else}}no{{/if}}",
+            "{{#unless flag}}yes{{else if flag}}maybe{{else}}no{{/unless}}",
+            "<ul>\n  {{#each items}}\n  <li>{{name}}</li>\n  {{/each}}\n</ul>\n",
+            "{{#each items}}\n{{> item}}\n{{/each}}\n",
+            "{{~#each items~}} {{name}} {{~/each~}}",
+            "{{#*inline \"name\"}}[{{name}}]{{/inline}}{{#each items}}{{> name}}{{/each}}",
+            "\\{{escaped}} \\\\{{flag}} {{!-- {{comment}} --}}",
+            "{{{{raw}}}} {{flag}} {{{{/raw}}}}"
+        })
+        {
+            HandlebarsOptions options;
+            options.noEscape = true;
+            auto expected = hbs.try_render(templ, ctx, options);
+            auto rendered = hbs.try_render(Handlebars::compile(templ), ctx, options);
+            if (!expected)
+            {
+                BOOST_TEST_NOT(rendered);
+            }
+            else if (BOOST_TEST(rendered))
+            {
+                BOOST_TEST(*rendered == *expected);
+            }
+        }
+    }
+
+    // Copies share the compiled template
+    {
+        Handlebars hbs;
+        HandlebarsTemplate tmpl = Handlebars::compile("{{a}}-{{b}}");
+        HandlebarsTemplate copy = tmpl;
+        BOOST_TEST(copy.text().data() == tmpl.text().data());
+        dom::Object ctx;
+        ctx.set("a", 1);
+        ctx.set("b", 2);
+        BOOST_TEST(hbs.render(copy, ctx, {}) == "1-2");
+    }
+
+    // Empty template
+    {
+        Handlebars hbs;
+        HandlebarsTemplate tmpl;
+        BOOST_TEST(tmpl.text().empty());
+        BOOST_TEST(hbs.render(tmpl, dom::Object{}, {}).empty());
+    }
+}
+
 void
 safe_string()
 {
@@ -5393,6 +5472,11 @@ mustache_compat_spec()
             {
                 return;
             }
+            rendered = hbs.render(Handlebars::compile(template_str), context, opt);
+            if (!BOOST_TEST(rendered == expected))
+            {
+                return;
+            }
         }
     }
 }
@@ -5401,6 +5485,7 @@ void
 run()
 {
     master_test();
+    compiled_templates();
     safe_string();
     basic_context();
     whitespace_control();
@@ -0,0 +1,195 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/OutputSink.hpp"
+#include "lib/Support/Path.hpp"
+#include <mrdocs/Support/Path.hpp>
+#include <test_suite/test_suite.hpp>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Process.h>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+namespace {
+
+// Move the modification time of a file an hour
+// back, so a rewritten file gets another time on
+// file systems with a coarse resolution
+bool
+makeOld(std::string const& path)
+{
+    namespace fs = llvm::sys::fs;
+    fs::file_status status;
+    if (fs::status(path, status))
+    {
+        return false;
+    }
+    int fd;
+    if (fs::openFileForWrite(path, fd, fs::CD_OpenExisting, fs::OF_Append))
+    {
+        return false;
+    }
+    bool const ok = !fs::setLastAccessAndModificationTime(fd,
+        status.getLastModificationTime() - std::chrono::hours(1));
+    llvm::sys::Process::SafelyCloseFileDescriptor(fd);
+    return ok;
+}
+
+llvm::sys::TimePoint<>
+modificationTime(std::string const& path)
+{
+    llvm::sys::fs::file_status status;
+    if (llvm::sys::fs::status(path, status))
+    {
+        return {};
+    }
+    return status.getLastModificationTime();
+}
+
+std::string
+contents(std::string const& path)
+{
+    auto buffer = llvm::MemoryBuffer::getFile(path);
+    if (!buffer)
+    {
+        return {};
+    }
+    return (*buffer)->getBuffer().str();
+}
+
+} // (anon)
+
+struct OutputSink_test
+{
+    ScopedTempDirectory dir_{"output-sink"};
+
+    std::string
+    path(std::string_view name) const
+    {
+        return files::appendPath(dir_.path(), name);
+    }
+
+    void
+    testSkipUnchanged()
+    {
+        OutputSink sink(true);
+        std::string const page = path("skip/index.html");
+        BOOST_TEST(sink.write(page, "<p>page</p>"));
+        BOOST_TEST(contents(page) == "<p>page</p>");
+        BOOST_TEST(sink.written() == 1);
+        BOOST_TEST(sink.unchanged() == 0);
+
+        // an identical page keeps its modification time
+        BOOST_TEST(makeOld(page));
+        auto const old = modificationTime(page);
+        BOOST_TEST(sink.write(page, "<p>page</p>"));
+        BOOST_TEST(modificationTime(page) == old);
+        BOOST_TEST(sink.written() == 1);
+        BOOST_TEST(sink.unchanged() == 1);
+
+        // a changed page of the same size is rewritten
+        BOOST_TEST(sink.write(page, "<p>Page</p>"));
+        BOOST_TEST(contents(page) == "<p>Page</p>");
+        BOOST_TEST(modificationTime(page) != old);
+        BOOST_TEST(sink.written() == 2);
+        BOOST_TEST(sink.unchanged() == 1);
+
+        // a changed page of another size is rewritten
+        BOOST_TEST(makeOld(page));
+        auto const older = modificationTime(page);
+        BOOST_TEST(sink.write(page, "<p>A longer page</p>"));
+        BOOST_TEST(contents(page) == "<p>A longer page</p>");
+        BOOST_TEST(modificationTime(page) != older);
+        BOOST_TEST(sink.written() == 3);
+        BOOST_TEST(sink.unchanged() == 1);
+    }
+
+    void
+    testAlwaysWrite()
+    {
+        OutputSink sink(false);
+        std::string const page = path("always/index.html");
+        BOOST_TEST(sink.write(page, "<p>page</p>"));
+        BOOST_TEST(makeOld(page));
+        auto const old = modificationTime(page);
+
+        // an identical page is rewritten
+        BOOST_TEST(sink.write(page, "<p>page</p>"));
+        BOOST_TEST(contents(page) == "<p>page</p>");
+        BOOST_TEST(modificationTime(page) != old);
+        BOOST_TEST(sink.written() == 2);
+        BOOST_TEST(sink.unchanged() == 0);
+    }
+
+    void
+    testMissingParent()
+    {
+        OutputSink sink(true);
+
+        // the missing parent directories are created
+        std::string const page = path("missing/a/b/c/page.adoc");
+        BOOST_TEST(sink.write(page, "= Page\n"));
+        BOOST_TEST(contents(page) == "= Page\n");
+
+        // pages written concurrently to the
+        // same missing directory
+        std::vector<std::thread> threads;
+        std::vector<int> ok(8, 0);
+        for (std::size_t i = 0; i < ok.size(); ++i)
+        {
+            threads.emplace_back([&, i]
+            {
+                ok[i] = static_cast<bool>(sink.write(
+                    path("concurrent/x/page" + std::to_string(i) + ".adoc"),
+                    "= Page\n"));
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        for (std::size_t i = 0; i < ok.size(); ++i)
+        {
+            BOOST_TEST(ok[i] == 1);
+            BOOST_TEST(contents(path(
+                "concurrent/x/page" + std::to_string(i) + ".adoc")) == "= Page\n");
+        }
+
+        // a parent which is a file
+        BOOST_TEST(sink.write(path("file"), "text"));
+        BOOST_TEST_NOT(sink.write(path("file/page.adoc"), "= Page\n"));
+    }
+
+    void
+    run()
+    {
+        BOOST_TEST(dir_);
+        if (!dir_)
+        {
+            return;
+        }
+        testSkipUnchanged();
+        testAlwaysWrite();
+        testMissingParent();
+    }
+};
+
+TEST_SUITE(
+    OutputSink_test,
+    "clang.mrdocs.OutputSink");
+
+} // mrdocs
+} // clang
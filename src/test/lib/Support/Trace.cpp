@@ -0,0 +1,141 @@
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// Copyright (c) 2024 Alan de Freitas (alandefreitas@gmail.com)
+//
+// Official repository: https://github.com/cppalliance/mrdocs
+//
+
+#include "lib/Support/Path.hpp"
+#include "lib/Support/Trace.hpp"
+#include <test_suite/test_suite.hpp>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace clang {
+namespace mrdocs {
+
+struct Trace_test
+{
+    void
+    testDisabled()
+    {
+        trace::reset();
+        BOOST_TEST_NOT(trace::enabled());
+        {
+            trace::Span span("Disabled");
+        }
+        BOOST_TEST(trace::size() == 0);
+    }
+
+    void
+    testWrite()
+    {
+        trace::start();
+        BOOST_TEST(trace::enabled());
+        {
+            trace::Span outer("Outer", "a \"quoted\" detail");
+            trace::Span inner("Inner");
+        }
+        {
+            // Discarded, since it is shorter
+            // than the minimum duration
+            trace::Span span("Short", {}, std::chrono::seconds(10));
+        }
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 3; ++i)
+        {
+            threads.emplace_back([]
+            {
+                trace::Span span("Worker");
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        BOOST_TEST(trace::size() == 5);
+        BOOST_TEST(trace::total("Outer") >= trace::total("Inner"));
+        BOOST_TEST(trace::total("Short") == std::chrono::microseconds(0));
+
+        ScopedTempFile file("trace", "json");
+        BOOST_TEST(file);
+        auto exp = trace::write(std::string(file.path()));
+        BOOST_TEST(exp);
+        trace::reset();
+
+        auto buffer = llvm::MemoryBuffer::getFile(file.path());
+        BOOST_TEST(buffer);
+        if (!buffer)
+        {
+            return;
+        }
+        auto json = llvm::json::parse((*buffer)->getBuffer());
+        BOOST_TEST(static_cast<bool>(json));
+        if (!json)
+        {
+            llvm::consumeError(json.takeError());
+            return;
+        }
+        llvm::json::Array const* events =
+            json->getAsObject()->getArray("traceEvents");
+        BOOST_TEST(events);
+        if (!events)
+        {
+            return;
+        }
+
+        std::vector<std::string> names;
+        std::set<std::int64_t> workerThreads;
+        std::int64_t mainThread = 0;
+        for (llvm::json::Value const& v : *events)
+        {
+            llvm::json::Object const& e = *v.getAsObject();
+            if (*e.getString("ph") != "X")
+            {
+                continue;
+            }
+            std::string const name(*e.getString("name"));
+            names.push_back(name);
+            BOOST_TEST(static_cast<bool>(e.getInteger("ts")));
+            BOOST_TEST(static_cast<bool>(e.getInteger("dur")));
+            if (name == "Worker")
+            {
+                workerThreads.insert(*e.getInteger("tid"));
+            }
+            else if (name == "Outer")
+            {
+                mainThread = *e.getInteger("tid");
+                BOOST_TEST(
+                    *e.getObject("args")->getString("detail") ==
+                    "a \"quoted\" detail");
+            }
+        }
+        BOOST_TEST(names.size() == 5);
+        BOOST_TEST(std::ranges::count(names, "Short") == 0);
+        BOOST_TEST(workerThreads.size() == 3);
+        BOOST_TEST(workerThreads.count(mainThread) == 0);
+    }
+
+    void
+    run()
+    {
+        testDisabled();
+        testWrite();
+    }
+};
+
+TEST_SUITE(
+    Trace_test,
+    "clang.mrdocs.Trace");
+
+} // mrdocs
+} // clang
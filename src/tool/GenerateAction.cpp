@@ -16,10 +16,12 @@
 #include "lib/Lib/CorpusImpl.hpp"
 #include "lib/Lib/MrDocsCompilationDatabase.hpp"
 #include "lib/Support/Path.hpp"
+#include "lib/Support/Trace.hpp"
 #include "llvm/Support/Program.h"
 #include <mrdocs/Generators.hpp>
 #include <mrdocs/Support/Error.hpp>
 #include <mrdocs/Support/Path.hpp>
+#include <mrdocs/Support/ScopeExit.hpp>
 #include <mrdocs/Support/ThreadPool.hpp>
 #include <clang/Tooling/JSONCompilationDatabase.h>
 
@@ -83,41 +85,15 @@ generateCompileCommandsFile(llvm::StringRef inputPath, llvm::StringRef cmakeArgs
     return Unexpected(Error("Input path is not a directory, a CMakeLists.txt file, or a compile_commands.json file"));
 }
 
-} // anonymous namespace
-
+/** Extract the symbols of the compilation database.
 
-Expected<void>
-DoGenerateAction(
-    std::string const& configPath,
-    ReferenceDirectories const& dirs,
-    char const** argv)
+    The compilation database is found or generated
+    according to the configuration.
+ */
+Expected<std::unique_ptr<Corpus>>
+buildCorpus(std::shared_ptr<ConfigImpl const> const& config)
 {
-    // --------------------------------------------------------------
-    //
-    // Load configuration
-    //
-    // --------------------------------------------------------------
-    Config::Settings publicSettings;
-    MRDOCS_TRY(Config::Settings::load_file(publicSettings, configPath, dirs));
-    MRDOCS_TRY(toolArgs.apply(publicSettings, dirs, argv));
-    MRDOCS_TRY(publicSettings.normalize(dirs));
-    ThreadPool threadPool(publicSettings.concurrency);
-    MRDOCS_TRY(
-        std::shared_ptr<ConfigImpl const> config,
-        ConfigImpl::load(publicSettings, dirs, threadPool));
-
-    // --------------------------------------------------------------
-    //
-    // Load generator
-    //
-    // --------------------------------------------------------------
     auto& settings = config->settings();
-    MRDOCS_TRY(
-        Generator const& generator,
-        getGenerators().find(to_string(settings.generator)),
-        formatError(
-            "the Generator \"{}\" was not found",
-            to_string(config->settings().generator)));
 
     // --------------------------------------------------------------
     //
@@ -185,9 +161,84 @@ DoGenerateAction(
     // Build corpus
     //
     // --------------------------------------------------------------
+    return CorpusImpl::build(config, compilationDatabase);
+}
+
+} // anonymous namespace
+
+
+Expected<void>
+DoGenerateAction(
+    std::string const& configPath,
+    ReferenceDirectories const& dirs,
+    char const** argv)
+{
+    // --------------------------------------------------------------
+    //
+    // Load configuration
+    //
+    // --------------------------------------------------------------
+    Config::Settings publicSettings;
+    MRDOCS_TRY(Config::Settings::load_file(publicSettings, configPath, dirs));
+    MRDOCS_TRY(toolArgs.apply(publicSettings, dirs, argv));
+    MRDOCS_TRY(publicSettings.normalize(dirs));
+
+    // Record the spans of the run, which are written
+    // even if the run fails
+    if (!publicSettings.traceFile.empty())
+    {
+        trace::start();
+    }
+    ScopeExit writeTrace([&traceFile = publicSettings.traceFile]
+    {
+        if (!trace::enabled())
+        {
+            return;
+        }
+        if (auto exp = trace::write(traceFile); !exp)
+        {
+            report::warn("Failed to write the trace: {}", exp.error());
+            return;
+        }
+        report::info("Wrote the trace to \"{}\"", traceFile);
+    });
+
+    ThreadPool threadPool(publicSettings.concurrency);
+    MRDOCS_TRY(
+        std::shared_ptr<ConfigImpl const> config,
+        ConfigImpl::load(publicSettings, dirs, threadPool));
+
+    // --------------------------------------------------------------
+    //
+    // Load generator
+    //
+    // --------------------------------------------------------------
+    auto& settings = config->settings();
     MRDOCS_TRY(
-        std::unique_ptr<Corpus> corpus,
-        CorpusImpl::build(config, compilationDatabase));
+        Generator const& generator,
+        getGenerators().find(to_string(settings.generator)),
+        formatError(
+            "the Generator \"{}\" was not found",
+            to_string(config->settings().generator)));
+
+    // --------------------------------------------------------------
+    //
+    // Build or load corpus
+    //
+    // --------------------------------------------------------------
+    std::unique_ptr<Corpus> corpus;
+    if (!settings.loadCorpus.empty())
+    {
+        MRDOCS_TRY(corpus, CorpusImpl::load(config, settings.loadCorpus));
+    }
+    else
+    {
+        MRDOCS_TRY(corpus, buildCorpus(config));
+        if (!settings.saveCorpus.empty())
+        {
+            MRDOCS_TRY(CorpusImpl::save(*corpus, settings.saveCorpus));
+        }
+    }
     if (corpus->empty())
     {
         report::warn("Corpus is empty, not generating docs");